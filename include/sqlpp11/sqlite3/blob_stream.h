@@ -0,0 +1,113 @@
+/*
+ * Copyright (c) 2013 - 2016, Roland Bock
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ *   Redistributions of source code must retain the above copyright notice, this
+ *   list of conditions and the following disclaimer.
+ *
+ *   Redistributions in binary form must reproduce the above copyright notice, this
+ *   list of conditions and the following disclaimer in the documentation and/or
+ *   other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON
+ * ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef SQLPP_SQLITE3_BLOB_STREAM_H
+#define SQLPP_SQLITE3_BLOB_STREAM_H
+
+#ifdef SQLPP_USE_SQLCIPHER
+#include <sqlcipher/sqlite3.h>
+#else
+#include <sqlite3.h>
+#endif
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <sqlpp11/sqlite3/export.h>
+
+#ifdef _MSC_VER
+#pragma warning(push)
+#pragma warning(disable : 4251)
+#endif
+
+namespace sqlpp
+{
+  namespace sqlite3
+  {
+    class connection;
+    class logger;
+
+    //! incremental access to a single blob, as opened by connection::open_blob.
+    // The size of a blob cannot be changed via the stream, use zeroblob() to preallocate space for writing.
+    // Reading and writing fail once the row has been modified or deleted by another statement, see reopen().
+    class SQLPP11_SQLITE3_EXPORT blob_stream
+    {
+      friend ::sqlpp::sqlite3::connection;
+      ::sqlite3* _db = nullptr;
+      sqlite3_blob* _blob = nullptr;
+      size_t _position = 0;
+      std::shared_ptr<logger> _log;  // the connection's
+
+      blob_stream(::sqlite3* db, sqlite3_blob* blob, std::shared_ptr<logger> log);
+
+    public:
+      blob_stream() = default;
+      blob_stream(const blob_stream&) = delete;
+      blob_stream(blob_stream&& rhs) noexcept;
+      blob_stream& operator=(const blob_stream&) = delete;
+      blob_stream& operator=(blob_stream&& rhs) noexcept;
+      ~blob_stream();
+
+      bool is_open() const
+      {
+        return _blob != nullptr;
+      }
+
+      //! size of the blob in bytes
+      size_t size() const;
+
+      //! read up to size bytes starting at offset into buffer, returns the number of bytes read
+      size_t read(uint8_t* buffer, size_t size, size_t offset) const;
+
+      //! write size bytes starting at offset, the blob must be large enough
+      void write(const uint8_t* data, size_t size, size_t offset);
+
+      //! sequential reading and writing, starting at the current position
+      size_t read(uint8_t* buffer, size_t size);
+      void write(const uint8_t* data, size_t size);
+
+      size_t tell() const
+      {
+        return _position;
+      }
+
+      void seek(size_t position)
+      {
+        _position = position;
+      }
+
+      //! move the stream to the same column of another row, cheaper than opening a new stream
+      void reopen(int64_t rowid);
+
+      void close();
+    };
+  }  // namespace sqlite3
+}  // namespace sqlpp
+
+#ifdef _MSC_VER
+#pragma warning(pop)
+#endif
+
+#endif
@@ -0,0 +1,135 @@
+/*
+ * Copyright (c) 2013 - 2015, Roland Bock
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ *   Redistributions of source code must retain the above copyright notice, this
+ *   list of conditions and the following disclaimer.
+ *
+ *   Redistributions in binary form must reproduce the above copyright notice, this
+ *   list of conditions and the following disclaimer in the documentation and/or
+ *   other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON
+ * ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef SQLPP_SQLITE3_CARRAY_H
+#define SQLPP_SQLITE3_CARRAY_H
+
+#include <sqlpp11/detail/type_vector.h>
+#include <sqlpp11/serialize.h>
+#include <sqlpp11/sqlite3/connection.h>
+#include <sqlpp11/type_traits.h>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace sqlpp
+{
+  namespace sqlite3
+  {
+    // The value of a carray parameter: all elements are bound as one parameter, without copying
+    template <typename ValueType>
+    struct carray_value_t
+    {
+      using _element_t = typename ValueType::_cpp_value_type;
+      static_assert(std::is_same<_element_t, int64_t>::value or std::is_same<_element_t, double>::value or
+                        std::is_same<_element_t, std::string>::value,
+                    "Sqlite3: carray() supports integral, floating_point and text values only");
+      using _value_t = std::vector<_element_t>;
+
+      carray_value_t() = default;
+      carray_value_t(_value_t value) : _value(std::move(value))
+      {
+      }
+
+      carray_value_t& operator=(_value_t value)
+      {
+        _value = std::move(value);
+        return *this;
+      }
+
+      const _value_t& value() const
+      {
+        return _value;
+      }
+
+      template <typename Target>
+      void _bind(Target& target, size_t index) const
+      {
+        target._bind_carray_parameter(index, &_value);
+      }
+
+      _value_t _value;
+    };
+
+    // A parameter which is serialized as a sub-select of the bundled carray table-valued function.
+    // Since the statement does not depend on the number of elements, it can be prepared once for lists of any size.
+    template <typename ValueType, typename NameType>
+    struct carray_t
+    {
+      using _traits = make_traits<ValueType, tag::is_parameter, tag::is_expression>;
+      using _nodes = ::sqlpp::detail::type_vector<>;
+      using _parameters = ::sqlpp::detail::type_vector<carray_t>;
+      using _can_be_null = std::false_type;
+      using _is_literal_expression = std::true_type;
+
+      using _instance_t = member_t<NameType, carray_value_t<ValueType>>;
+
+      carray_t() = default;
+      carray_t(const carray_t&) = default;
+      carray_t(carray_t&&) = default;
+      carray_t& operator=(const carray_t&) = default;
+      carray_t& operator=(carray_t&&) = default;
+      ~carray_t() = default;
+    };
+
+    //! a std::vector parameter for in() and not_in(), e.g.
+    //   auto prepared = db.prepare(select(tab.beta).from(tab).where(tab.alpha.in(carray(tab.alpha))));
+    //   prepared.params.alpha = std::vector<int64_t>{1, 2, 3};
+    // Supported element types are integral, floating_point and text.
+    template <typename NamedExpr>
+    auto carray(const NamedExpr&) -> carray_t<value_type_of<NamedExpr>, NamedExpr>
+    {
+      static_assert(is_selectable_t<NamedExpr>::value, "Sqlite3: carray() requires a named expression");
+      return {};
+    }
+
+    template <typename ValueType, typename AliasProvider>
+    auto carray(const ValueType&, const AliasProvider&) -> carray_t<ValueType, AliasProvider>
+    {
+      static_assert(is_value_type_t<ValueType>::value, "Sqlite3: first argument of carray() is not a value type");
+      static_assert(is_alias_provider_t<AliasProvider>::value,
+                    "Sqlite3: second argument of carray() is not an alias provider");
+      return {};
+    }
+  }  // namespace sqlite3
+
+  template <typename ValueType, typename NameType>
+  struct serializer_t<sqlite3::serializer_t, sqlite3::carray_t<ValueType, NameType>>
+  {
+    using _serialize_check = consistent_t;
+    using T = sqlite3::carray_t<ValueType, NameType>;
+
+    static sqlite3::serializer_t& _(const T& /*t*/, sqlite3::serializer_t& context)
+    {
+      context << "SELECT value FROM sqlpp_carray(?" << context.count() << ")";
+      context.pop_count();
+      return context;
+    }
+  };
+}  // namespace sqlpp
+
+#endif
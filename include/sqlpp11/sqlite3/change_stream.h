@@ -0,0 +1,131 @@
+/*
+ * Copyright (c) 2015 - 2016, Roland Bock
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ *  * Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ * LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE
+ * OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ * OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef SQLPP_SQLITE3_CHANGE_STREAM_H
+#define SQLPP_SQLITE3_CHANGE_STREAM_H
+
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <sqlpp11/sqlite3/export.h>
+#include <string>
+#include <vector>
+
+#ifdef _MSC_VER
+#pragma warning(push)
+#pragma warning(disable : 4251)
+#endif
+
+namespace sqlpp
+{
+  namespace sqlite3
+  {
+    class connection;
+
+    //! SQLITE_* fundamental datatypes
+    enum class value_type
+    {
+      null,
+      integer,
+      floating_point,
+      text,
+      blob,
+    };
+
+    //! decoded column value of a row_change
+    struct column_value
+    {
+      value_type type = value_type::null;
+      int64_t integer = 0;
+      double floating_point = 0.0;
+      std::string bytes;  // text or blob
+
+      bool is_null() const
+      {
+        return type == value_type::null;
+      }
+    };
+
+    enum class change_operation
+    {
+      insert,
+      update,
+      remove,
+    };
+
+    //! before and after image of a row
+    struct row_change
+    {
+      change_operation operation = change_operation::insert;
+      std::string schema;
+      std::string table;
+      int64_t old_rowid = 0;               // rowid before the change (update, remove)
+      int64_t new_rowid = 0;               // rowid after the change (insert, update)
+      std::vector<column_value> old_values;  // empty for inserts
+      std::vector<column_value> new_values;  // empty for removals
+    };
+
+    //! Streams the row changes made through a connection to a publisher running in a background thread.
+    // Changes are collected by a preupdate hook, queued once their transaction has committed (and dropped when it
+    // or the savepoint they belong to rolls back) and passed to publish in commit order. The connection only blocks
+    // if the queue is full.
+    // Commits are noticed by the statements run through the connection: changes committed using native_handle() or
+    // by a select (e.g. with RETURNING) are queued with the next statement, or when the stream is destroyed.
+    // Savepoints created with plain SQL are not tracked.
+    // Requires sqlite3 compiled with SQLITE_ENABLE_PREUPDATE_HOOK (see runtime_features().preupdate_hook), and
+    // SQLITE_ENABLE_PREUPDATE_HOOK defined when compiling this library (the CMake option SQLITE3_ENABLE_PREUPDATE_HOOK,
+    // on if sqlite3 provides the hook).
+    // The connection must outlive the stream, which replaces its commit and rollback hooks.
+    class SQLPP11_SQLITE3_EXPORT change_stream
+    {
+    public:
+      struct state;
+      using publisher = std::function<void(const row_change&)>;
+
+      change_stream(connection& db, publisher publish, size_t capacity = 4096);
+      change_stream(const change_stream&) = delete;
+      change_stream(change_stream&&) = delete;
+      change_stream& operator=(const change_stream&) = delete;
+      change_stream& operator=(change_stream&&) = delete;
+      //! detaches from the connection and publishes the remaining changes
+      ~change_stream();
+
+      //! wait until every change committed so far has been published
+      void flush();
+
+      //! number of changes published so far
+      size_t published() const;
+
+    private:
+      std::unique_ptr<state> _state;
+    };
+  }  // namespace sqlite3
+}  // namespace sqlpp
+
+#ifdef _MSC_VER
+#pragma warning(pop)
+#endif
+
+#endif
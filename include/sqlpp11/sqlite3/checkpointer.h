@@ -0,0 +1,86 @@
+/*
+ * Copyright (c) 2015 - 2016, Roland Bock
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ *  * Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ * LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE
+ * OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ * OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef SQLPP_SQLITE3_CHECKPOINTER_H
+#define SQLPP_SQLITE3_CHECKPOINTER_H
+
+#include <memory>
+#include <sqlpp11/sqlite3/connection.h>
+#include <sqlpp11/sqlite3/connection_config.h>
+#include <sqlpp11/sqlite3/export.h>
+
+#ifdef _MSC_VER
+#pragma warning(push)
+#pragma warning(disable : 4251)
+#endif
+
+namespace sqlpp
+{
+  namespace sqlite3
+  {
+    //! Runs WAL checkpoints in a background thread, using a connection of its own.
+    // Watched connections no longer checkpoint when committing (their autocheckpoint is replaced by a WAL hook).
+    // Instead, they wake up the checkpointer once the WAL has grown to frame_threshold frames.
+    // The checkpointer must outlive the connections it watches (or unwatch them before being destroyed).
+    class SQLPP11_SQLITE3_EXPORT background_checkpointer
+    {
+    public:
+      struct state;
+
+      background_checkpointer(connection_config config,
+                              checkpoint_mode mode = checkpoint_mode::passive,
+                              int frame_threshold = 1000);
+      background_checkpointer(const background_checkpointer&) = delete;
+      background_checkpointer(background_checkpointer&&) = delete;
+      background_checkpointer& operator=(const background_checkpointer&) = delete;
+      background_checkpointer& operator=(background_checkpointer&&) = delete;
+      ~background_checkpointer();
+
+      //! move checkpoints of db to the background thread
+      void watch(connection& db);
+
+      //! restore the autocheckpoint threshold db had when it was first watched
+      void unwatch(connection& db);
+
+      //! checkpoint as soon as possible, regardless of the WAL size
+      void request();
+
+      //! number of checkpoints run so far
+      size_t checkpoint_count() const;
+
+      //! result of the most recent checkpoint
+      checkpoint_result last_result() const;
+
+    private:
+      std::unique_ptr<state> _state;
+    };
+  }  // namespace sqlite3
+}  // namespace sqlpp
+
+#ifdef _MSC_VER
+#pragma warning(pop)
+#endif
+
+#endif
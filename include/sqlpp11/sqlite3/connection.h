@@ -36,13 +36,24 @@
 #include <sqlpp11/schema.h>
 #include <sqlpp11/serialize.h>
 #include <sqlpp11/sqlite3/bind_result.h>
+#include <sqlpp11/sqlite3/blob_stream.h>
 #include <sqlpp11/sqlite3/connection_config.h>
+#include <sqlpp11/sqlite3/container_table.h>
+#include <sqlpp11/sqlite3/features.h>
+#include <sqlpp11/sqlite3/function.h>
+#include <sqlpp11/sqlite3/latency.h>
 #include <sqlpp11/sqlite3/prepared_statement.h>
+#include <sqlpp11/sqlite3/serialized_database.h>
+#include <sqlpp11/sqlite3/session.h>
+#include <sqlpp11/sqlite3/statistics.h>
 #include <sqlpp11/transaction.h>
 #include <sqlpp11/type_traits.h>
 #include <sqlpp11/sqlite3/export.h>
+#include <chrono>
+#include <functional>
 #include <sstream>
 #include <string>
+#include <vector>
 
 #ifdef _MSC_VER
 #pragma warning(push)
@@ -56,10 +67,29 @@ namespace sqlpp
     namespace detail
     {
       struct connection_handle;
+      struct transaction_observer;
     }
 
     class connection;
 
+    enum class checkpoint_mode
+    {
+      passive = SQLITE_CHECKPOINT_PASSIVE,
+      full = SQLITE_CHECKPOINT_FULL,
+      restart = SQLITE_CHECKPOINT_RESTART,
+      truncate = SQLITE_CHECKPOINT_TRUNCATE
+    };
+
+    struct checkpoint_result
+    {
+      int log_frames;           // size of the WAL in frames (-1 if the database is not in WAL mode)
+      int checkpointed_frames;  // number of frames written back into the database (-1 if not in WAL mode)
+      bool busy;                // the checkpoint could not complete due to concurrent readers or writers
+    };
+
+    //! called after each backup step with the number of pages still to be copied and the total number of pages
+    using backup_progress_t = std::function<void(int remaining, int page_count)>;
+
     struct serializer_t
     {
       serializer_t(const connection& db) : _db(db), _count(1)
@@ -94,6 +124,12 @@ namespace sqlpp
       size_t _count;
     };
 
+    class connection;
+
+    //! start a transaction with the given mode, e.g. to take the write lock right away
+    inline sqlpp::transaction_t<connection> start_transaction(
+        connection& db, transaction_mode mode, bool report_unfinished_transaction = report_auto_rollback);
+
     class SQLPP11_SQLITE3_EXPORT connection : public sqlpp::connection
     {
       std::unique_ptr<detail::connection_handle> _handle;
@@ -105,6 +141,24 @@ namespace sqlpp
       };
 
       transaction_status_type _transaction_status = transaction_status_type::none;
+      size_t _savepoint_depth = 0;  // number of savepoints nested in the active transaction
+
+      // used instead of the default mode by the next start_transaction() only
+      bool _has_next_transaction_mode = false;
+      transaction_mode _next_transaction_mode = transaction_mode::deferred;
+      friend sqlpp::transaction_t<connection> start_transaction(connection& db,
+                                                                transaction_mode mode,
+                                                                bool report_unfinished_transaction);
+
+      // text of the statement run by run_serialized(), used instead of serializing that statement again
+      const void* _serialized_for = nullptr;
+      std::string _serialized_statement;
+
+      template <typename Statement>
+      std::string statement_text(const Statement& statement);
+
+      // RELEASE (or ROLLBACK TO and RELEASE) the innermost savepoint
+      void end_savepoint(bool rollback);
 
       // direct execution
       bind_result_t select_impl(const std::string& statement);
@@ -120,6 +174,29 @@ namespace sqlpp
       size_t run_prepared_update_impl(prepared_statement_t& prepared_statement);
       size_t run_prepared_remove_impl(prepared_statement_t& prepared_statement);
 
+      // user defined functions (the destroy function is called for function_data in any case)
+      void register_function_impl(const std::string& name,
+                                  int arity,
+                                  int flags,
+                                  void* function_data,
+                                  void (*call)(sqlite3_context*, int, sqlite3_value**),
+                                  void (*step)(sqlite3_context*, int, sqlite3_value**),
+                                  void (*final)(sqlite3_context*),
+                                  void (*destroy)(void*));
+      void create_module_impl(const std::string& name,
+                              const sqlite3_module* module,
+                              void* client_data,
+                              void (*destroy)(void*));
+#if SQLITE_VERSION_NUMBER >= 3025000
+      void register_window_function_impl(const std::string& name,
+                                         int arity,
+                                         int flags,
+                                         void (*step)(sqlite3_context*, int, sqlite3_value**),
+                                         void (*final)(sqlite3_context*),
+                                         void (*value)(sqlite3_context*),
+                                         void (*inverse)(sqlite3_context*, int, sqlite3_value**));
+#endif
+
     public:
       using _prepared_statement_t = prepared_statement_t;
       using _context_t = serializer_t;
@@ -154,16 +231,14 @@ namespace sqlpp
       template <typename Select>
       bind_result_t select(const Select& s)
       {
-        _context_t context(*this);
-        serialize(s, context);
-        return select_impl(context.str());
+        return select_impl(statement_text(s));
       }
 
       template <typename Select>
       _prepared_statement_t prepare_select(Select& s)
       {
         _context_t context(*this);
-        serialize(s, context);
+        ::sqlpp::serialize(s, context);
         return prepare_impl(context.str());
       }
 
@@ -179,16 +254,14 @@ namespace sqlpp
       template <typename Insert>
       size_t insert(const Insert& i)
       {
-        _context_t context(*this);
-        serialize(i, context);
-        return insert_impl(context.str());
+        return insert_impl(statement_text(i));
       }
 
       template <typename Insert>
       _prepared_statement_t prepare_insert(Insert& i)
       {
         _context_t context(*this);
-        serialize(i, context);
+        ::sqlpp::serialize(i, context);
         return prepare_impl(context.str());
       }
 
@@ -204,16 +277,14 @@ namespace sqlpp
       template <typename Update>
       size_t update(const Update& u)
       {
-        _context_t context(*this);
-        serialize(u, context);
-        return update_impl(context.str());
+        return update_impl(statement_text(u));
       }
 
       template <typename Update>
       _prepared_statement_t prepare_update(Update& u)
       {
         _context_t context(*this);
-        serialize(u, context);
+        ::sqlpp::serialize(u, context);
         return prepare_impl(context.str());
       }
 
@@ -229,16 +300,14 @@ namespace sqlpp
       template <typename Remove>
       size_t remove(const Remove& r)
       {
-        _context_t context(*this);
-        serialize(r, context);
-        return remove_impl(context.str());
+        return remove_impl(statement_text(r));
       }
 
       template <typename Remove>
       _prepared_statement_t prepare_remove(Remove& r)
       {
         _context_t context(*this);
-        serialize(r, context);
+        ::sqlpp::serialize(r, context);
         return prepare_impl(context.str());
       }
 
@@ -258,16 +327,14 @@ namespace sqlpp
           typename Enable = typename std::enable_if<not std::is_convertible<Execute, std::string>::value, void>::type>
       size_t execute(const Execute& x)
       {
-        _context_t context(*this);
-        serialize(x, context);
-        return execute(context.str());
+        return execute(statement_text(x));
       }
 
       template <typename Execute>
       _prepared_statement_t prepare_execute(Execute& x)
       {
         _context_t context(*this);
-        serialize(x, context);
+        ::sqlpp::serialize(x, context);
         return prepare_impl(context.str());
       }
 
@@ -298,6 +365,11 @@ namespace sqlpp
         return _run(t, sqlpp::run_check_t<_serializer_context_t, T>{});
       }
 
+      //! same as operator(), with text being the statement as serialized for this connection, e.g. for inspecting
+      // it beforehand without serializing it twice
+      template <typename T>
+      auto run_serialized(const T& t, std::string text) -> decltype((*this)(t));
+
       //! call prepare on the argument
       template <typename T>
       auto _prepare(const T& t, const std::true_type&) -> decltype(t._prepare(*this))
@@ -316,33 +388,218 @@ namespace sqlpp
         return _prepare(t, sqlpp::prepare_check_t<_serializer_context_t, T>{});
       }
 
-      //! set the transaction isolation level for this connection
+      //! set the transaction isolation level for this connection (read_uncommitted or not, the default transaction
+      // mode is not changed)
       void set_default_isolation_level(isolation_level level);
 
       //! get the currently active transaction isolation level
       isolation_level get_default_isolation_level();
 
-      //! start transaction
+      //! set the mode used by start_transaction() if none is given
+      void set_default_transaction_mode(transaction_mode mode);
+
+      //! get the mode used by start_transaction() if none is given
+      transaction_mode get_default_transaction_mode() const;
+
+      //! start transaction. If a transaction is active already, a savepoint is started instead, which is released
+      // or rolled back to by the matching commit or rollback. Only the outermost commit makes changes durable.
       void start_transaction();
 
-      //! commit transaction (or throw if the transaction has been finished already)
+      //! start transaction with the given mode (ignored for nested transactions)
+      void start_transaction(transaction_mode mode);
+
+      //! start transaction, mapping the isolation level to a mode: serializable is exclusive, repeatable_read is
+      // immediate, read_committed and read_uncommitted are deferred, undefined uses the default mode.
+      void start_transaction(isolation_level level);
+
+      //! commit the innermost transaction or savepoint (or throw if the transaction has been finished already)
       void commit_transaction();
 
-      //! rollback transaction with or without reporting the rollback (or throw if the transaction has been finished
-      // already)
+      //! rollback the innermost transaction or savepoint with or without reporting the rollback (or throw if the
+      // transaction has been finished already)
       void rollback_transaction(bool report);
 
+      //! number of nested transactions currently open (0 if there is no active transaction)
+      size_t transaction_depth() const;
+
+      //! receives the diagnostics of this connection (connection_config::log)
+      const std::shared_ptr<logger>& get_logger() const;
+
+      //! told about the transactions of this connection, nullptr to detach (used by change_stream)
+      void _set_transaction_observer(detail::transaction_observer* observer);
+
       //! report a rollback failure (will be called by transactions in case of a rollback failure in the destructor)
       void report_rollback_failure(const std::string message) noexcept;
 
       //! get the last inserted id
       uint64_t last_insert_id() noexcept;
 
+      //! prepare (but do not run) the statement to tell whether it leaves the database unchanged
+      bool is_read_only(const std::string& statement);
+
       ::sqlite3* native_handle();
 
+      //! features of the sqlite3 library in use, probed when the first connection is opened
+      const library_features& features() const;
+
+      //! register a callable (e.g. a lambda) as SQL scalar function.
+      // Argument and result types are deduced from its signature: integral and floating point types, std::string,
+      // const char*, std::vector<uint8_t> and sqlite3_value* (for raw access). Exceptions are reported as SQL errors.
+      // Flags may contain SQLITE_DETERMINISTIC, SQLITE_INNOCUOUS and SQLITE_DIRECTONLY.
+      template <typename Callable>
+      void register_function(const std::string& name, Callable callable, int flags = 0)
+      {
+        using _function_t = detail::scalar_function_t<Callable>;
+        register_function_impl(name, detail::signature_of<Callable>::_arity, flags, new Callable(std::move(callable)),
+                               &_function_t::call, nullptr, nullptr, &_function_t::destroy);
+      }
+
+      //! register an aggregate function. Aggregate must be default constructible and provide step(args...) (argument
+      // types as for register_function) and final(). One Aggregate is constructed per group, in memory owned by
+      // sqlite3.
+      template <typename Aggregate>
+      void register_aggregate(const std::string& name, int flags = 0)
+      {
+        using _aggregate_t = detail::aggregate_function_t<Aggregate>;
+        register_function_impl(name, detail::signature_of<decltype(&Aggregate::step)>::_arity, flags, nullptr,
+                               nullptr, &_aggregate_t::step, &_aggregate_t::final, nullptr);
+      }
+
+#if SQLITE_VERSION_NUMBER >= 3025000
+      //! register an aggregate window function. In addition to the requirements of register_aggregate, Aggregate must
+      // provide inverse(args...) to remove a row from the window and value() to return the current result.
+      template <typename Aggregate>
+      void register_window_function(const std::string& name, int flags = 0)
+      {
+        using _aggregate_t = detail::aggregate_function_t<Aggregate>;
+        register_window_function_impl(name, detail::signature_of<decltype(&Aggregate::step)>::_arity, flags,
+                                      &_aggregate_t::step, &_aggregate_t::final, &_aggregate_t::value,
+                                      &_aggregate_t::inverse);
+      }
+#endif
+
+      //! expose a container (or any range with begin() and end()) as a read-only table, e.g.
+      //   db.create_container_table("sessions", sessions, container_key_column("id", &session_id), ...)
+      // Rows are streamed from the container without copying, so the container must outlive the connection and must
+      // not be modified while statements are using the table.
+      template <typename Container, typename... Columns>
+      void create_container_table(const std::string& name, const Container& container, Columns... columns)
+      {
+        using _table_t = detail::container_table<Container, Columns...>;
+        create_module_impl(name, _table_t::module(), new _table_t(container, std::move(columns)...),
+                           &_table_t::destroy);
+      }
+
       auto attach(const connection_config&, const std::string name) -> schema_t;
+
+      //! copy the given schema of this database into the main schema of target while this database stays usable.
+      // Copies pages_per_step pages per step (all pages if negative), sleeps between steps to let writers proceed.
+      void backup_to(connection& target,
+                     int pages_per_step = -1,
+                     std::chrono::milliseconds sleep_between_steps = std::chrono::milliseconds(0),
+                     const backup_progress_t& progress = {},
+                     const std::string& schema = "main");
+
+      //! same as above, opening the target database from the given config
+      void backup_to(const connection_config& target_config,
+                     int pages_per_step = -1,
+                     std::chrono::milliseconds sleep_between_steps = std::chrono::milliseconds(0),
+                     const backup_progress_t& progress = {},
+                     const std::string& schema = "main");
+
+      //! open the blob in the given column and row for incremental reading (and writing, if writable)
+      blob_stream open_blob(const std::string& table,
+                            const std::string& column,
+                            int64_t rowid,
+                            bool writable = false,
+                            const std::string& schema = "main");
+
+      //! memory and page cache statistics of this connection, deltas are relative to the previous call
+      connection_stats stats();
+
+      //! prepare/bind/step/decode/reset times per statement text since the connection was opened, empty unless
+      //! connection_config::latency_histograms is set
+      latency_report latency() const;
+
+      //! checkpoint the WAL of the given schema (all attached databases, if empty)
+      checkpoint_result checkpoint(checkpoint_mode mode = checkpoint_mode::passive, const std::string& schema = "");
+
+      //! record changes made through this connection to the tables with the given names (all tables if empty)
+      change_capture capture_changes(const std::vector<std::string>& tables);
+
+      //! record changes made through this connection to the given tables (all tables if none are given), e.g.
+      //   auto capture = db.capture_changes(tab);
+      template <typename... Tables>
+      change_capture capture_changes(const Tables&...)
+      {
+        return capture_changes(std::vector<std::string>{sqlpp::name_of<Tables>::char_ptr()...});
+      }
+
+      //! apply a changeset (e.g. recorded by capture_changes on another database) as a whole or not at all.
+      // Conflicting changes abort the apply (and throw) unless on_conflict decides otherwise.
+      void apply_changes(const changeset& changes, const conflict_handler& on_conflict = conflict_handler{});
+
+#if SQLITE_VERSION_NUMBER >= 3036000
+      //! copy the given schema into memory allocated by sqlite3
+      serialized_database serialize(const std::string& schema = "main");
+
+      //! replace the given schema by an in-memory database, handing the image's memory over to sqlite3 (no copy).
+      // The database stays writable and can grow.
+      void deserialize(serialized_database image, const std::string& schema = "main");
+
+      //! replace the given schema by an in-memory database, copying data into memory owned by sqlite3
+      void deserialize(const std::vector<uint8_t>& data, const std::string& schema = "main");
+
+      //! replace the given schema by an in-memory database using data directly, e.g. a mmap'd database file.
+      // The memory is not copied: it must stay valid and unchanged for as long as the schema is in use.
+      // Flags are SQLITE_DESERIALIZE_* values, leave SQLITE_DESERIALIZE_READONLY set unless data may be written to.
+      void deserialize(uint8_t* data,
+                       size_t size,
+                       unsigned int flags = SQLITE_DESERIALIZE_READONLY,
+                       const std::string& schema = "main");
+#endif
     };
 
+    inline sqlpp::transaction_t<connection> start_transaction(connection& db,
+                                                              transaction_mode mode,
+                                                              bool report_unfinished_transaction)
+    {
+      // sqlpp::transaction_t calls db.start_transaction(), which picks the mode up
+      db._next_transaction_mode = mode;
+      db._has_next_transaction_mode = true;
+      return sqlpp::start_transaction(db, report_unfinished_transaction);
+    }
+
+    template <typename T>
+    auto connection::run_serialized(const T& t, std::string text) -> decltype((*this)(t))
+    {
+      struct serialized_statement_guard
+      {
+        connection& db;
+        ~serialized_statement_guard()
+        {
+          db._serialized_for = nullptr;
+          db._serialized_statement.clear();
+        }
+      } guard{*this};
+      _serialized_statement = std::move(text);
+      _serialized_for = &t;
+      return (*this)(t);
+    }
+
+    template <typename Statement>
+    std::string connection::statement_text(const Statement& statement)
+    {
+      if (static_cast<const void*>(&statement) == _serialized_for)
+      {
+        _serialized_for = nullptr;
+        return std::move(_serialized_statement);
+      }
+      _context_t context(*this);
+      ::sqlpp::serialize(statement, context);
+      return context.str();
+    }
+
     inline std::string serializer_t::escape(std::string arg)
     {
       return _db.escape(arg);
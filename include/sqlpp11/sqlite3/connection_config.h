@@ -27,6 +27,8 @@
 #ifndef SQLPP_SQLITE3_CONNECTION_CONFIG_H
 #define SQLPP_SQLITE3_CONNECTION_CONFIG_H
 
+#include <memory>
+#include <sqlpp11/sqlite3/logger.h>
 #include <string>
 #include <iostream>
 
@@ -34,23 +36,38 @@ namespace sqlpp
 {
   namespace sqlite3
   {
+    //! how BEGIN acquires locks, see https://www.sqlite.org/lang_transaction.html
+    enum class transaction_mode
+    {
+      deferred,   // locks are acquired when the database is first read or written
+      immediate,  // the write lock is acquired right away, so the transaction never fails upgrading it
+      exclusive   // like immediate, and (outside of WAL mode) other connections may not read either
+    };
+
     struct connection_config
     {
-      connection_config() : path_to_database(), flags(0), vfs(), debug(false),password("")
+      connection_config() : path_to_database(), flags(0), vfs(), debug(false),password(""),
+            lookaside_slot_size(0), lookaside_slot_count(0), default_transaction_mode(transaction_mode::deferred),
+            prepare_flags(0), log(), latency_histograms(false)
       {
       }
       connection_config(const connection_config&) = default;
       connection_config(connection_config&&) = default;
 
       connection_config(std::string path, int fl = 0, std::string vf = "", bool dbg = false,std::string password="")
-          : path_to_database(std::move(path)), flags(fl), vfs(std::move(vf)), debug(dbg),password(password)
+          : path_to_database(std::move(path)), flags(fl), vfs(std::move(vf)), debug(dbg),password(password),
+            lookaside_slot_size(0), lookaside_slot_count(0), default_transaction_mode(transaction_mode::deferred),
+            prepare_flags(0), log(), latency_histograms(false)
       {
       }
 
       bool operator==(const connection_config& other) const
       {
         return (other.path_to_database == path_to_database && other.flags == flags && other.vfs == vfs &&
-                other.debug == debug && other.password==password);
+                other.debug == debug && other.password==password &&
+                other.lookaside_slot_size == lookaside_slot_size && other.lookaside_slot_count == lookaside_slot_count &&
+                other.default_transaction_mode == default_transaction_mode && other.prepare_flags == prepare_flags &&
+                other.log == log && other.latency_histograms == latency_histograms);
       }
 
       bool operator!=(const connection_config& other) const
@@ -64,6 +81,17 @@ namespace sqlpp
       std::string vfs;
       bool debug;
       std::string password;
+      // per connection lookaside memory (SQLITE_DBCONFIG_LOOKASIDE), used if both are > 0
+      int lookaside_slot_size;
+      int lookaside_slot_count;
+      transaction_mode default_transaction_mode;
+      // SQLITE_PREPARE_* flags for all statements, e.g. SQLITE_PREPARE_NO_VTAB (which also rules out carray
+      // parameters and container tables). Ignored if the library lacks sqlite3_prepare_v3.
+      unsigned int prepare_flags;
+      // receives diagnostics (debug records only if debug is set), default_logger() if nullptr
+      std::shared_ptr<logger> log;
+      // record prepare/bind/step/decode/reset times per statement text, see connection::latency()
+      bool latency_histograms;
     };
   }
 }
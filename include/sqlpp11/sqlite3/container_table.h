@@ -0,0 +1,636 @@
+/*
+ * Copyright (c) 2015 - 2016, Roland Bock
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ *  * Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ * LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE
+ * OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ * OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef SQLPP_SQLITE3_CONTAINER_TABLE_H
+#define SQLPP_SQLITE3_CONTAINER_TABLE_H
+
+#ifdef SQLPP_USE_SQLCIPHER
+#include <sqlcipher/sqlite3.h>
+#else
+#include <sqlite3.h>
+#endif
+#include <sqlpp11/detail/index_sequence.h>
+#include <sqlpp11/sqlite3/function.h>
+#include <cstdint>
+#include <exception>
+#include <functional>
+#include <new>
+#include <string>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#ifdef SQLPP_DYNAMIC_LOADING
+#include <sqlpp11/sqlite3/dynamic_libsqlite3.h>
+#endif
+
+namespace sqlpp
+{
+  namespace sqlite3
+  {
+    template <typename Accessor, bool IsKey>
+    struct container_column_t
+    {
+      static constexpr bool _is_key = IsKey;
+      std::string _name;
+      Accessor _accessor;
+    };
+
+    //! a column of a container table, the accessor maps an element of the container to the value of the column
+    template <typename Accessor>
+    container_column_t<Accessor, false> container_column(std::string name, Accessor accessor)
+    {
+      return {std::move(name), std::move(accessor)};
+    }
+
+    //! the key column of an associative container (at most one per table). Equality constraints on this column are
+    // answered via equal_range(), range constraints via lower_bound()/upper_bound() for containers ordered by
+    // std::less (other orders are scanned).
+    template <typename Accessor>
+    container_column_t<Accessor, true> container_key_column(std::string name, Accessor accessor)
+    {
+      return {std::move(name), std::move(accessor)};
+    }
+
+    namespace detail
+    {
+#ifdef SQLPP_DYNAMIC_LOADING
+      using namespace dynamic;
+#endif
+
+      template <typename T, typename Enable = void>
+      struct column_sql_type
+      {
+        static_assert(sizeof(T) == 0, "Sqlite3: Unsupported column type for a container table");
+      };
+
+      template <typename T>
+      struct column_sql_type<T, typename std::enable_if<std::is_integral<T>::value>::type>
+      {
+        static constexpr const char* value = "INTEGER";
+      };
+
+      template <typename T>
+      struct column_sql_type<T, typename std::enable_if<std::is_floating_point<T>::value>::type>
+      {
+        static constexpr const char* value = "REAL";
+      };
+
+      template <>
+      struct column_sql_type<std::string>
+      {
+        static constexpr const char* value = "TEXT";
+      };
+
+      template <>
+      struct column_sql_type<const char*>
+      {
+        static constexpr const char* value = "TEXT";
+      };
+
+      template <>
+      struct column_sql_type<std::vector<uint8_t>>
+      {
+        static constexpr const char* value = "BLOB";
+      };
+
+      // Values returned by reference point into the container, which must not change while a statement is running.
+      // They are therefore handed to sqlite3 without copying.
+      template <typename T, bool IsReference>
+      struct column_result_impl
+      {
+        static void set(sqlite3_context* context, const T& t)
+        {
+          function_value<T>::set(context, t);
+        }
+      };
+
+      template <>
+      struct column_result_impl<std::string, true>
+      {
+        static void set(sqlite3_context* context, const std::string& t)
+        {
+          sqlite3_result_text(context, t.data(), static_cast<int>(t.size()), SQLITE_STATIC);
+        }
+      };
+
+      template <>
+      struct column_result_impl<std::vector<uint8_t>, true>
+      {
+        static void set(sqlite3_context* context, const std::vector<uint8_t>& t)
+        {
+          sqlite3_result_blob(context, t.data(), static_cast<int>(t.size()), SQLITE_STATIC);
+        }
+      };
+
+      // Element is what dereferencing the container's iterator yields: if that is a temporary (e.g. of a proxy
+      // iterator), references returned by the accessor may point into it and are copied, too.
+      template <typename R, typename Element>
+      using column_result = column_result_impl<typename std::decay<R>::type,
+                                               std::is_lvalue_reference<R>::value and
+                                                   std::is_lvalue_reference<Element>::value>;
+
+      // Conversion of constraint values to keys. Only exact conversions are used for lookups, everything else falls
+      // back to a full scan (sqlite3 checks all constraints again anyway).
+      template <typename Key, typename Enable = void>
+      struct key_value
+      {
+        static bool get(sqlite3_value*, Key&)
+        {
+          return false;
+        }
+      };
+
+      template <typename Key>
+      struct key_value<Key, typename std::enable_if<std::is_integral<Key>::value>::type>
+      {
+        static bool get(sqlite3_value* value, Key& key)
+        {
+          if (sqlite3_value_type(value) != SQLITE_INTEGER)
+            return false;
+          key = static_cast<Key>(sqlite3_value_int64(value));
+          return static_cast<sqlite3_int64>(key) == sqlite3_value_int64(value);
+        }
+      };
+
+      template <typename Key>
+      struct key_value<Key, typename std::enable_if<std::is_floating_point<Key>::value>::type>
+      {
+        static bool get(sqlite3_value* value, Key& key)
+        {
+          const auto type = sqlite3_value_type(value);
+          if (type != SQLITE_INTEGER and type != SQLITE_FLOAT)
+            return false;
+          key = static_cast<Key>(sqlite3_value_double(value));
+          return true;
+        }
+      };
+
+      template <>
+      struct key_value<std::string>
+      {
+        static bool get(sqlite3_value* value, std::string& key)
+        {
+          if (sqlite3_value_type(value) != SQLITE_TEXT)
+            return false;
+          key = function_value<std::string>::get(value);
+          return true;
+        }
+      };
+
+      template <typename Container, typename Enable = void>
+      struct has_equal_range : public std::false_type
+      {
+      };
+
+      template <typename Container>
+      struct has_equal_range<Container,
+                             decltype(void(std::declval<const Container&>().equal_range(
+                                 std::declval<const typename Container::key_type&>())))> : public std::true_type
+      {
+      };
+
+      template <typename Container, typename Enable = void>
+      struct has_lower_bound : public std::false_type
+      {
+      };
+
+      template <typename Container>
+      struct has_lower_bound<Container,
+                             decltype(void(std::declval<const Container&>().lower_bound(
+                                 std::declval<const typename Container::key_type&>())))> : public std::true_type
+      {
+      };
+
+      template <typename Compare, typename Key>
+      struct is_ascending
+          : public std::integral_constant<bool,
+                                          std::is_same<Compare, std::less<Key>>::value or
+                                              std::is_same<Compare, std::less<void>>::value>
+      {
+      };
+
+      // Range lookups and ORDER BY rely on the container being sorted like sqlite3 sorts the keys, i.e. ascending.
+      template <typename Container, typename Enable = void>
+      struct has_ascending_keys : public std::false_type
+      {
+      };
+
+      template <typename Container>
+      struct has_ascending_keys<Container,
+                                typename std::enable_if<has_lower_bound<Container>::value and
+                                                        is_ascending<typename Container::key_compare,
+                                                                     typename Container::key_type>::value>::type>
+          : public std::true_type
+      {
+      };
+
+      template <bool... Bs>
+      struct true_count;
+
+      template <>
+      struct true_count<> : public std::integral_constant<int, 0>
+      {
+      };
+
+      template <bool B, bool... Bs>
+      struct true_count<B, Bs...> : public std::integral_constant<int, (B ? 1 : 0) + true_count<Bs...>::value>
+      {
+      };
+
+      // Eponymous-only virtual table module streaming the elements of a container (or any range with begin() and
+      // end()), see connection::create_container_table.
+      template <typename Container, typename... Columns>
+      struct container_table
+      {
+        static_assert(sizeof...(Columns) > 0, "Sqlite3: A container table requires at least one column");
+        static_assert(true_count<Columns::_is_key...>::value <= 1, "Sqlite3: A container table has at most one key column");
+
+        using _iterator_t = decltype(std::declval<const Container&>().begin());
+        using _element_t = decltype(*std::declval<_iterator_t>());
+        using _index_t = ::sqlpp::detail::make_index_sequence<sizeof...(Columns)>;
+
+        // bits of idxNum
+        enum plan : int
+        {
+          plan_eq = 1,
+          plan_gt = 2,
+          plan_ge = 4,
+          plan_lt = 8,
+          plan_le = 16,
+        };
+
+        struct vtab : public sqlite3_vtab
+        {
+          container_table* table;
+        };
+
+        struct cursor : public sqlite3_vtab_cursor
+        {
+          _iterator_t current;
+          _iterator_t end;
+          sqlite3_int64 rowid;  // position of current from begin(), the same for every scan
+        };
+
+        const Container& _container;
+        std::tuple<Columns...> _columns;
+        int _key_index;
+
+        container_table(const Container& container, Columns... columns)
+            : _container(container), _columns(std::move(columns)...), _key_index(find_key_index())
+        {
+        }
+
+        static int find_key_index()
+        {
+          const bool keys[] = {Columns::_is_key...};
+          for (size_t i = 0; i < sizeof...(Columns); ++i)
+          {
+            if (keys[i])
+              return static_cast<int>(i);
+          }
+          return -1;
+        }
+
+        template <typename Column>
+        static std::string column_declaration(const Column& column)
+        {
+          using _result_t = decltype(column._accessor(std::declval<_element_t>()));
+          return "\"" + column._name + "\" " + column_sql_type<typename std::decay<_result_t>::type>::value;
+        }
+
+        template <size_t... Is>
+        std::string declaration(const ::sqlpp::detail::index_sequence<Is...>&) const
+        {
+          const std::string columns[] = {column_declaration(std::get<Is>(_columns))...};
+          std::string sql = "CREATE TABLE x(";
+          for (size_t i = 0; i < sizeof...(Is); ++i)
+          {
+            if (i)
+              sql += ", ";
+            sql += columns[i];
+          }
+          return sql + ")";
+        }
+
+        template <size_t I>
+        static void set_column(container_table& table, sqlite3_context* context, _element_t element)
+        {
+          const auto& column = std::get<I>(table._columns);
+          column_result<decltype(column._accessor(element)), _element_t>::set(context, column._accessor(element));
+        }
+
+        template <size_t... Is>
+        void set_column(int index,
+                        sqlite3_context* context,
+                        _element_t element,
+                        const ::sqlpp::detail::index_sequence<Is...>&)
+        {
+          using _setter_t = void (*)(container_table&, sqlite3_context*, _element_t);
+          static const _setter_t setters[] = {&container_table::set_column<Is>...};
+          setters[index](*this, context, element);
+        }
+
+        void lookup_equal(cursor& c, sqlite3_value* value, const std::true_type&)
+        {
+          typename Container::key_type key;
+          if (key_value<typename Container::key_type>::get(value, key))
+          {
+            const auto range = _container.equal_range(key);
+            c.current = range.first;
+            c.end = range.second;
+          }
+        }
+
+        void lookup_equal(cursor&, sqlite3_value*, const std::false_type&)
+        {
+        }
+
+        void lookup_range(cursor& c, int plan, sqlite3_value** argv, const std::true_type&)
+        {
+          const auto less = _container.key_comp();
+          typename Container::key_type lower_key;
+          typename Container::key_type upper_key;
+          auto has_lower = false;
+          if (plan & (plan_gt | plan_ge))
+          {
+            has_lower = key_value<typename Container::key_type>::get(*argv, lower_key);
+            if (has_lower)
+              c.current = (plan & plan_gt) ? _container.upper_bound(lower_key) : _container.lower_bound(lower_key);
+            ++argv;
+          }
+          if (plan & (plan_lt | plan_le))
+          {
+            if (key_value<typename Container::key_type>::get(*argv, upper_key))
+            {
+              // crossing bounds would yield an end before the start
+              if (has_lower and (less(upper_key, lower_key) or
+                                 (not less(lower_key, upper_key) and (plan & (plan_gt | plan_lt)))))
+                c.end = c.current;
+              else
+                c.end = (plan & plan_lt) ? _container.lower_bound(upper_key) : _container.upper_bound(upper_key);
+            }
+          }
+        }
+
+        void lookup_range(cursor&, int, sqlite3_value**, const std::false_type&)
+        {
+        }
+
+        int best_index(sqlite3_index_info* info) const
+        {
+          const auto can_lookup = has_equal_range<Container>::value;
+          const auto is_ordered = has_ascending_keys<Container>::value;
+          int equal = -1;
+          int lower = -1;
+          int upper = -1;
+          int plan = 0;
+          for (int i = 0; i < info->nConstraint; ++i)
+          {
+            const auto& constraint = info->aConstraint[i];
+            if (not constraint.usable or _key_index < 0 or constraint.iColumn != _key_index)
+              continue;
+            switch (constraint.op)
+            {
+              case SQLITE_INDEX_CONSTRAINT_EQ:
+                if (can_lookup)
+                  equal = i;
+                break;
+              case SQLITE_INDEX_CONSTRAINT_GT:
+              case SQLITE_INDEX_CONSTRAINT_GE:
+                if (is_ordered)
+                {
+                  lower = i;
+                  plan = (plan & ~(plan_gt | plan_ge)) |
+                         (constraint.op == SQLITE_INDEX_CONSTRAINT_GT ? plan_gt : plan_ge);
+                }
+                break;
+              case SQLITE_INDEX_CONSTRAINT_LT:
+              case SQLITE_INDEX_CONSTRAINT_LE:
+                if (is_ordered)
+                {
+                  upper = i;
+                  plan = (plan & ~(plan_lt | plan_le)) |
+                         (constraint.op == SQLITE_INDEX_CONSTRAINT_LT ? plan_lt : plan_le);
+                }
+                break;
+              default:
+                break;
+            }
+          }
+
+          // constraints are not omitted: keys that cannot be converted exactly fall back to a scan
+          if (equal >= 0)
+          {
+            info->idxNum = plan_eq;
+            info->aConstraintUsage[equal].argvIndex = 1;
+            info->estimatedCost = 1.0;
+            info->estimatedRows = 1;
+          }
+          else
+          {
+            info->idxNum = plan;
+            int argv_index = 1;
+            double cost = 1000000.0;
+            if (lower >= 0)
+            {
+              info->aConstraintUsage[lower].argvIndex = argv_index++;
+              cost /= 10;
+            }
+            if (upper >= 0)
+            {
+              info->aConstraintUsage[upper].argvIndex = argv_index++;
+              cost /= 10;
+            }
+            info->estimatedCost = cost;
+            info->estimatedRows = static_cast<sqlite3_int64>(cost);
+          }
+
+          if (is_ordered and info->nOrderBy == 1 and _key_index >= 0 and
+              info->aOrderBy[0].iColumn == _key_index and not info->aOrderBy[0].desc)
+          {
+            info->orderByConsumed = 1;
+          }
+          return SQLITE_OK;
+        }
+
+        // sqlite3_module callbacks
+        static int x_connect(::sqlite3* db, void* aux, int, const char* const*, sqlite3_vtab** result, char**)
+        {
+          try
+          {
+            auto table = static_cast<container_table*>(aux);
+            const auto rc = sqlite3_declare_vtab(db, table->declaration(_index_t{}).c_str());
+            if (rc != SQLITE_OK)
+              return rc;
+            auto v = new vtab();
+            v->table = table;
+            *result = v;
+            return SQLITE_OK;
+          }
+          catch (const std::bad_alloc&)
+          {
+            return SQLITE_NOMEM;
+          }
+          catch (...)
+          {
+            return SQLITE_ERROR;
+          }
+        }
+
+        static int x_best_index(sqlite3_vtab* v, sqlite3_index_info* info)
+        {
+          return static_cast<vtab*>(v)->table->best_index(info);
+        }
+
+        static int x_disconnect(sqlite3_vtab* v)
+        {
+          delete static_cast<vtab*>(v);
+          return SQLITE_OK;
+        }
+
+        static int x_open(sqlite3_vtab*, sqlite3_vtab_cursor** result)
+        {
+          auto c = new (std::nothrow) cursor();
+          if (not c)
+            return SQLITE_NOMEM;
+          *result = c;
+          return SQLITE_OK;
+        }
+
+        static int x_close(sqlite3_vtab_cursor* c)
+        {
+          delete static_cast<cursor*>(c);
+          return SQLITE_OK;
+        }
+
+        static int x_filter(sqlite3_vtab_cursor* base, int plan, const char*, int, sqlite3_value** argv)
+        {
+          auto& c = *static_cast<cursor*>(base);
+          auto& table = *static_cast<vtab*>(base->pVtab)->table;
+          try
+          {
+            c.current = table._container.begin();
+            c.end = table._container.end();
+            if (plan & plan_eq)
+              table.lookup_equal(c, argv[0], has_equal_range<Container>{});
+            else if (plan)
+              table.lookup_range(c, plan, argv, has_ascending_keys<Container>{});
+            // sqlite3 removes duplicates by rowid, e.g. when combining the lookups of an OR
+            c.rowid = 0;
+            for (auto it = table._container.begin(); it != c.current; ++it)
+              ++c.rowid;
+            return SQLITE_OK;
+          }
+          catch (const std::bad_alloc&)
+          {
+            return SQLITE_NOMEM;
+          }
+          catch (...)
+          {
+            // nothing may unwind through sqlite3's C frames, e.g. from a comparator
+            return SQLITE_ERROR;
+          }
+        }
+
+        static int x_next(sqlite3_vtab_cursor* base)
+        {
+          auto& c = *static_cast<cursor*>(base);
+          ++c.current;
+          ++c.rowid;
+          return SQLITE_OK;
+        }
+
+        static int x_eof(sqlite3_vtab_cursor* base)
+        {
+          const auto& c = *static_cast<cursor*>(base);
+          return c.current == c.end;
+        }
+
+        static int x_column(sqlite3_vtab_cursor* base, sqlite3_context* context, int index)
+        {
+          auto& c = *static_cast<cursor*>(base);
+          try
+          {
+            static_cast<vtab*>(base->pVtab)->table->set_column(index, context, *c.current, _index_t{});
+          }
+          catch (const std::bad_alloc&)
+          {
+            sqlite3_result_error_nomem(context);
+          }
+          catch (const std::exception& e)
+          {
+            sqlite3_result_error(context, e.what(), -1);
+          }
+          catch (...)
+          {
+            sqlite3_result_error(context, "unknown exception", -1);
+          }
+          return SQLITE_OK;
+        }
+
+        static int x_rowid(sqlite3_vtab_cursor* base, sqlite3_int64* rowid)
+        {
+          *rowid = static_cast<cursor*>(base)->rowid;
+          return SQLITE_OK;
+        }
+
+        static void destroy(void* table)
+        {
+          delete static_cast<container_table*>(table);
+        }
+
+        // no xCreate: the table exists in every schema under the name of the module
+        static const sqlite3_module* module()
+        {
+          static const sqlite3_module m = make_module();
+          return &m;
+        }
+
+        static sqlite3_module make_module()
+        {
+          sqlite3_module m = {};
+          m.iVersion = 0;
+          m.xCreate = nullptr;
+          m.xConnect = &x_connect;
+          m.xBestIndex = &x_best_index;
+          m.xDisconnect = &x_disconnect;
+          m.xDestroy = &x_disconnect;
+          m.xOpen = &x_open;
+          m.xClose = &x_close;
+          m.xFilter = &x_filter;
+          m.xNext = &x_next;
+          m.xEof = &x_eof;
+          m.xColumn = &x_column;
+          m.xRowid = &x_rowid;
+          return m;
+        }
+      };
+    }  // namespace detail
+  }    // namespace sqlite3
+}  // namespace sqlpp
+
+#endif
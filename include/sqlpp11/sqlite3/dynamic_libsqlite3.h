@@ -32,6 +32,8 @@
 #include <sqlite3.h>
 #endif
 #include <stdexcept>
+#include <string>
+#include <vector>
 
 // namespace for internal sqlite function wrappers - when using this instead of sqlite3 direct linking
 // do this:
@@ -46,9 +48,13 @@ namespace sqlpp
   {
     namespace dynamic
     {
-      /// load the SQLite libraries, optionally providing the filename (leave empty for default)
+      /// load the SQLite libraries, optionally providing the filename (leave empty for default).
+      /// The library is loaded only once per process, later calls (with any filename) return right away.
       void init_sqlite(std::string libname);
 
+      /// names of the optional functions which are missing in the loaded library (their pointers are nullptr)
+      std::vector<std::string> missing_symbols();
+
 #define DYNDEFINE(NAME) extern decltype(::NAME)* NAME
 
       DYNDEFINE(sqlite3_open_v2);
@@ -68,9 +74,7 @@ namespace sqlpp
       DYNDEFINE(sqlite3_bind_text);
       DYNDEFINE(sqlite3_bind_value);
       DYNDEFINE(sqlite3_libversion_number);
-      //    DYNDEFINE(sqlite3_compileoption_used);
       DYNDEFINE(sqlite3_threadsafe);
-      //    DYNDEFINE(sqlite3_close_v2);
       DYNDEFINE(sqlite3_shutdown);
       DYNDEFINE(sqlite3_config);
       DYNDEFINE(sqlite3_db_config);
@@ -85,30 +89,27 @@ namespace sqlpp
       DYNDEFINE(sqlite3_busy_timeout);
       DYNDEFINE(sqlite3_get_table);
       DYNDEFINE(sqlite3_free_table);
-      //    DYNDEFINE(sqlite3_realloc64);
       DYNDEFINE(sqlite3_free);
-      //    DYNDEFINE(sqlite3_msize);
       DYNDEFINE(sqlite3_memory_used);
       DYNDEFINE(sqlite3_memory_highwater);
       DYNDEFINE(sqlite3_randomness);
       DYNDEFINE(sqlite3_set_authorizer);
       DYNDEFINE(sqlite3_progress_handler);
       DYNDEFINE(sqlite3_open16);
-      //    DYNDEFINE(sqlite3_uri_boolean);
-      //    DYNDEFINE(sqlite3_uri_int64);
       DYNDEFINE(sqlite3_errcode);
       DYNDEFINE(sqlite3_errmsg);
+      DYNDEFINE(sqlite3_errstr);
       DYNDEFINE(sqlite3_extended_errcode);
       DYNDEFINE(sqlite3_limit);
       DYNDEFINE(sqlite3_prepare);
       DYNDEFINE(sqlite3_prepare16);
       DYNDEFINE(sqlite3_prepare16_v2);
-      //    DYNDEFINE(sqlite3_stmt_readonly);
-      //    DYNDEFINE(sqlite3_stmt_busy);
-      //    DYNDEFINE(sqlite3_bind_blob64);
       DYNDEFINE(sqlite3_bind_text16);
-      //    DYNDEFINE(sqlite3_bind_text64);
       DYNDEFINE(sqlite3_bind_zeroblob);
+#if SQLITE_VERSION_NUMBER >= 3020000
+      DYNDEFINE(sqlite3_bind_pointer);
+      DYNDEFINE(sqlite3_value_pointer);
+#endif
       DYNDEFINE(sqlite3_bind_parameter_count);
       DYNDEFINE(sqlite3_bind_parameter_index);
       DYNDEFINE(sqlite3_clear_bindings);
@@ -127,7 +128,13 @@ namespace sqlpp
       DYNDEFINE(sqlite3_reset);
       DYNDEFINE(sqlite3_create_function);
       DYNDEFINE(sqlite3_create_function16);
-      //    DYNDEFINE(sqlite3_create_function_v2);
+      DYNDEFINE(sqlite3_create_function_v2);
+#if SQLITE_VERSION_NUMBER >= 3025000
+      DYNDEFINE(sqlite3_create_window_function);
+#endif
+      DYNDEFINE(sqlite3_aggregate_context);
+      DYNDEFINE(sqlite3_user_data);
+      DYNDEFINE(sqlite3_value_blob);
       DYNDEFINE(sqlite3_value_bytes);
       DYNDEFINE(sqlite3_value_bytes16);
       DYNDEFINE(sqlite3_value_double);
@@ -135,9 +142,9 @@ namespace sqlpp
       DYNDEFINE(sqlite3_value_int64);
       DYNDEFINE(sqlite3_value_type);
       DYNDEFINE(sqlite3_value_numeric_type);
+      DYNDEFINE(sqlite3_value_text);
       DYNDEFINE(sqlite3_set_auxdata);
       DYNDEFINE(sqlite3_result_blob);
-      //    DYNDEFINE(sqlite3_result_blob64);
       DYNDEFINE(sqlite3_result_double);
       DYNDEFINE(sqlite3_result_error);
       DYNDEFINE(sqlite3_result_error16);
@@ -148,7 +155,6 @@ namespace sqlpp
       DYNDEFINE(sqlite3_result_int64);
       DYNDEFINE(sqlite3_result_null);
       DYNDEFINE(sqlite3_result_text);
-      //    DYNDEFINE(sqlite3_result_text64);
       DYNDEFINE(sqlite3_result_text16);
       DYNDEFINE(sqlite3_result_text16le);
       DYNDEFINE(sqlite3_result_text16be);
@@ -173,17 +179,13 @@ namespace sqlpp
 #endif
       DYNDEFINE(sqlite3_sleep);
       DYNDEFINE(sqlite3_get_autocommit);
-      //    DYNDEFINE(sqlite3_db_readonly);
       DYNDEFINE(sqlite3_next_stmt);
       DYNDEFINE(sqlite3_enable_shared_cache);
       DYNDEFINE(sqlite3_release_memory);
-      //    DYNDEFINE(sqlite3_db_release_memory);
-      //    DYNDEFINE(sqlite3_soft_heap_limit64);
       DYNDEFINE(sqlite3_table_column_metadata);
       DYNDEFINE(sqlite3_load_extension);
       DYNDEFINE(sqlite3_enable_load_extension);
       DYNDEFINE(sqlite3_auto_extension);
-      //    DYNDEFINE(sqlite3_cancel_auto_extension);
       DYNDEFINE(sqlite3_reset_auto_extension);
       DYNDEFINE(sqlite3_create_module);
       DYNDEFINE(sqlite3_create_module_v2);
@@ -194,6 +196,7 @@ namespace sqlpp
       DYNDEFINE(sqlite3_blob_bytes);
       DYNDEFINE(sqlite3_blob_read);
       DYNDEFINE(sqlite3_blob_write);
+      DYNDEFINE(sqlite3_blob_reopen);
       DYNDEFINE(sqlite3_vfs_find);
       DYNDEFINE(sqlite3_vfs_register);
       DYNDEFINE(sqlite3_vfs_unregister);
@@ -202,12 +205,11 @@ namespace sqlpp
       DYNDEFINE(sqlite3_mutex_enter);
       DYNDEFINE(sqlite3_mutex_try);
       DYNDEFINE(sqlite3_mutex_leave);
-      //    DYNDEFINE(sqlite3_mutex_held);
-      //    DYNDEFINE(sqlite3_mutex_notheld);
       DYNDEFINE(sqlite3_db_mutex);
       DYNDEFINE(sqlite3_file_control);
       DYNDEFINE(sqlite3_test_control);
       DYNDEFINE(sqlite3_status);
+      DYNDEFINE(sqlite3_status64);
       DYNDEFINE(sqlite3_db_status);
       DYNDEFINE(sqlite3_stmt_status);
       DYNDEFINE(sqlite3_backup_init);
@@ -216,17 +218,77 @@ namespace sqlpp
       DYNDEFINE(sqlite3_backup_remaining);
       DYNDEFINE(sqlite3_backup_pagecount);
       DYNDEFINE(sqlite3_unlock_notify);
-      //    DYNDEFINE(sqlite3_stricmp);
-      //    DYNDEFINE(sqlite3_strnicmp);
-      //    DYNDEFINE(sqlite3_strglob);
-      //    DYNDEFINE(sqlite3_log);
-      //    DYNDEFINE(sqlite3_wal_autocheckpoint);
-      //    DYNDEFINE(sqlite3_wal_checkpoint);
-      //    DYNDEFINE(sqlite3_wal_checkpoint_v2);
-      //    DYNDEFINE(sqlite3_vtab_config);
-      //    DYNDEFINE(sqlite3_vtab_on_conflict);
-      //    DYNDEFINE(sqlite3_rtree_geometry_callback);
-      //    DYNDEFINE(sqlite3_rtree_query_callback);
+#if SQLITE_VERSION_NUMBER >= 3036000
+      DYNDEFINE(sqlite3_malloc64);
+      DYNDEFINE(sqlite3_serialize);
+      DYNDEFINE(sqlite3_deserialize);
+#endif
+      DYNDEFINE(sqlite3_wal_autocheckpoint);
+      DYNDEFINE(sqlite3_wal_checkpoint_v2);
+      DYNDEFINE(sqlite3_wal_hook);
+      DYNDEFINE(sqlite3_commit_hook);
+      DYNDEFINE(sqlite3_rollback_hook);
+
+      // optional: newer or depending on compile options, nullptr if missing in the loaded library
+      DYNDEFINE(sqlite3_compileoption_used);
+      DYNDEFINE(sqlite3_compileoption_get);
+      DYNDEFINE(sqlite3_libversion);
+      DYNDEFINE(sqlite3_sourceid);
+      DYNDEFINE(sqlite3_log);
+      DYNDEFINE(sqlite3_vtab_config);
+      DYNDEFINE(sqlite3_vtab_on_conflict);
+      DYNDEFINE(sqlite3_rtree_geometry_callback);
+      DYNDEFINE(sqlite3_mutex_held);
+      DYNDEFINE(sqlite3_mutex_notheld);
+#if SQLITE_VERSION_NUMBER >= 3008007
+      DYNDEFINE(sqlite3_close_v2);
+      DYNDEFINE(sqlite3_realloc64);
+      DYNDEFINE(sqlite3_msize);
+      DYNDEFINE(sqlite3_uri_boolean);
+      DYNDEFINE(sqlite3_uri_int64);
+      DYNDEFINE(sqlite3_stmt_readonly);
+      DYNDEFINE(sqlite3_stmt_busy);
+      DYNDEFINE(sqlite3_bind_blob64);
+      DYNDEFINE(sqlite3_bind_text64);
+      DYNDEFINE(sqlite3_result_blob64);
+      DYNDEFINE(sqlite3_result_text64);
+      DYNDEFINE(sqlite3_db_readonly);
+      DYNDEFINE(sqlite3_db_release_memory);
+      DYNDEFINE(sqlite3_soft_heap_limit64);
+      DYNDEFINE(sqlite3_cancel_auto_extension);
+      DYNDEFINE(sqlite3_stricmp);
+      DYNDEFINE(sqlite3_strnicmp);
+      DYNDEFINE(sqlite3_strglob);
+      DYNDEFINE(sqlite3_wal_checkpoint);
+      DYNDEFINE(sqlite3_rtree_query_callback);
+#endif
+#if SQLITE_VERSION_NUMBER >= 3010000
+      DYNDEFINE(sqlite3_snapshot_get);
+      DYNDEFINE(sqlite3_snapshot_open);
+      DYNDEFINE(sqlite3_snapshot_free);
+#endif
+#if SQLITE_VERSION_NUMBER >= 3014000
+      DYNDEFINE(sqlite3_trace_v2);
+      DYNDEFINE(sqlite3_expanded_sql);
+#endif
+#if SQLITE_VERSION_NUMBER >= 3020000
+      DYNDEFINE(sqlite3_prepare_v3);
+#endif
+#ifdef SQLITE_ENABLE_SESSION
+      DYNDEFINE(sqlite3session_create);
+      DYNDEFINE(sqlite3session_delete);
+      DYNDEFINE(sqlite3session_attach);
+      DYNDEFINE(sqlite3session_changeset);
+      DYNDEFINE(sqlite3session_isempty);
+      DYNDEFINE(sqlite3changeset_apply);
+      DYNDEFINE(sqlite3changeset_op);
+#endif
+#ifdef SQLITE_ENABLE_PREUPDATE_HOOK
+      DYNDEFINE(sqlite3_preupdate_hook);
+      DYNDEFINE(sqlite3_preupdate_old);
+      DYNDEFINE(sqlite3_preupdate_new);
+      DYNDEFINE(sqlite3_preupdate_count);
+#endif
     }  // namespace dynamic
   }    // namespace sqlite3
 }  // namespace sqlpp
@@ -0,0 +1,70 @@
+/*
+ * Copyright (c) 2013 - 2016, Roland Bock
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ *   Redistributions of source code must retain the above copyright notice, this
+ *   list of conditions and the following disclaimer.
+ *
+ *   Redistributions in binary form must reproduce the above copyright notice, this
+ *   list of conditions and the following disclaimer in the documentation and/or
+ *   other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON
+ * ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef SQLPP_SQLITE3_FEATURES_H
+#define SQLPP_SQLITE3_FEATURES_H
+
+#include <sqlpp11/sqlite3/export.h>
+
+namespace sqlpp
+{
+  namespace sqlite3
+  {
+    //! what the sqlite3 library in use supports, which may differ from the headers the connector was compiled with
+    // (especially with dynamic loading). Features backed by functions also require the connector's compile-time
+    // support.
+    struct library_features
+    {
+      int version_number = 0;  // sqlite3_libversion_number()
+      int threadsafe = 0;      // sqlite3_threadsafe()
+
+      // SQL
+      bool upsert = false;            // INSERT ... ON CONFLICT, 3.24.0
+      bool returning = false;         // RETURNING, 3.35.0
+      bool window_functions = false;  // built-in and user defined window functions, 3.25.0
+      bool json = false;              // json functions, built in since 3.38.0
+      bool math_functions = false;    // SQLITE_ENABLE_MATH_FUNCTIONS
+      bool fts5 = false;              // SQLITE_ENABLE_FTS5
+      bool rtree = false;             // SQLITE_ENABLE_RTREE
+
+      // API
+      bool prepare_v3 = false;      // sqlite3_prepare_v3, 3.20.0
+      bool carray = false;          // sqlite3_bind_pointer, required for carray parameters, 3.20.0
+      bool serialize = false;       // sqlite3_serialize/sqlite3_deserialize
+      bool snapshot = false;        // SQLITE_ENABLE_SNAPSHOT
+      bool preupdate_hook = false;  // SQLITE_ENABLE_PREUPDATE_HOOK
+      bool session = false;         // SQLITE_ENABLE_SESSION
+      bool unlock_notify = false;   // SQLITE_ENABLE_UNLOCK_NOTIFY
+      bool shared_cache = false;    // not SQLITE_OMIT_SHARED_CACHE
+      bool lookaside = false;       // not SQLITE_OMIT_LOOKASIDE
+    };
+
+    //! probe the library once (loading it first, in case of dynamic loading), later calls return the same result
+    SQLPP11_SQLITE3_EXPORT const library_features& runtime_features();
+  }  // namespace sqlite3
+}  // namespace sqlpp
+
+#endif
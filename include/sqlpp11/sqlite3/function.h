@@ -0,0 +1,422 @@
+/*
+ * Copyright (c) 2015 - 2016, Roland Bock
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ *  * Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ * LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE
+ * OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ * OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef SQLPP_SQLITE3_FUNCTION_H
+#define SQLPP_SQLITE3_FUNCTION_H
+
+#ifdef SQLPP_USE_SQLCIPHER
+#include <sqlcipher/sqlite3.h>
+#else
+#include <sqlite3.h>
+#endif
+#include <sqlpp11/detail/index_sequence.h>
+#include <cstdint>
+#include <exception>
+#include <new>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+#ifdef SQLPP_DYNAMIC_LOADING
+#include <sqlpp11/sqlite3/dynamic_libsqlite3.h>
+#endif
+
+namespace sqlpp
+{
+  namespace sqlite3
+  {
+    namespace detail
+    {
+#ifdef SQLPP_DYNAMIC_LOADING
+      using namespace dynamic;
+#endif
+
+      // Conversion between sqlite3 values and C++ types for user defined functions
+      template <typename T, typename Enable = void>
+      struct function_value
+      {
+        static_assert(sizeof(T) == 0, "Sqlite3: Unsupported argument or result type for a user defined function");
+      };
+
+      template <typename T>
+      struct function_value<T, typename std::enable_if<std::is_integral<T>::value>::type>
+      {
+        static T get(sqlite3_value* value)
+        {
+          return static_cast<T>(sqlite3_value_int64(value));
+        }
+
+        static void set(sqlite3_context* context, T t)
+        {
+          sqlite3_result_int64(context, static_cast<sqlite3_int64>(t));
+        }
+      };
+
+      template <typename T>
+      struct function_value<T, typename std::enable_if<std::is_floating_point<T>::value>::type>
+      {
+        static T get(sqlite3_value* value)
+        {
+          return static_cast<T>(sqlite3_value_double(value));
+        }
+
+        static void set(sqlite3_context* context, T t)
+        {
+          sqlite3_result_double(context, static_cast<double>(t));
+        }
+      };
+
+      template <>
+      struct function_value<std::string>
+      {
+        static std::string get(sqlite3_value* value)
+        {
+          const auto text = reinterpret_cast<const char*>(sqlite3_value_text(value));
+          return text ? std::string(text, static_cast<size_t>(sqlite3_value_bytes(value))) : std::string();
+        }
+
+        static void set(sqlite3_context* context, const std::string& t)
+        {
+          sqlite3_result_text(context, t.data(), static_cast<int>(t.size()), SQLITE_TRANSIENT);
+        }
+      };
+
+      // no copy: the text is valid during the function call only
+      template <>
+      struct function_value<const char*>
+      {
+        static const char* get(sqlite3_value* value)
+        {
+          return reinterpret_cast<const char*>(sqlite3_value_text(value));
+        }
+
+        static void set(sqlite3_context* context, const char* t)
+        {
+          if (t)
+            sqlite3_result_text(context, t, -1, SQLITE_TRANSIENT);
+          else
+            sqlite3_result_null(context);
+        }
+      };
+
+      template <>
+      struct function_value<std::vector<uint8_t>>
+      {
+        static std::vector<uint8_t> get(sqlite3_value* value)
+        {
+          const auto blob = static_cast<const uint8_t*>(sqlite3_value_blob(value));
+          return blob ? std::vector<uint8_t>(blob, blob + sqlite3_value_bytes(value)) : std::vector<uint8_t>();
+        }
+
+        static void set(sqlite3_context* context, const std::vector<uint8_t>& t)
+        {
+          sqlite3_result_blob(context, t.data(), static_cast<int>(t.size()), SQLITE_TRANSIENT);
+        }
+      };
+
+      // raw access, e.g. to check for NULL via sqlite3_value_type
+      template <>
+      struct function_value<sqlite3_value*>
+      {
+        static sqlite3_value* get(sqlite3_value* value)
+        {
+          return value;
+        }
+
+        static void set(sqlite3_context* context, sqlite3_value* t)
+        {
+          sqlite3_result_value(context, t);
+        }
+      };
+
+      // Calls function with arguments decoded from argv and sets the result of the sqlite3 context
+      template <typename Result>
+      struct function_result
+      {
+        template <typename Function, typename... Args, size_t... Is>
+        static void call(sqlite3_context* context,
+                         Function& function,
+                         sqlite3_value** argv,
+                         const ::sqlpp::detail::index_sequence<Is...>&)
+        {
+          function_value<Result>::set(context, function(function_value<Args>::get(argv[Is])...));
+        }
+      };
+
+      template <>
+      struct function_result<void>
+      {
+        template <typename Function, typename... Args, size_t... Is>
+        static void call(sqlite3_context* context,
+                         Function& function,
+                         sqlite3_value** argv,
+                         const ::sqlpp::detail::index_sequence<Is...>&)
+        {
+          function(function_value<Args>::get(argv[Is])...);
+          sqlite3_result_null(context);
+        }
+      };
+
+      // Signature of functions, function pointers, lambdas and other function objects
+      template <typename Callable>
+      struct signature_of : public signature_of<decltype(&Callable::operator())>
+      {
+      };
+
+      template <typename Result, typename... Args>
+      struct signature_of<Result (*)(Args...)>
+      {
+        using _result_t = typename std::decay<Result>::type;
+        template <template <typename, typename...> class Target, typename... Prefix>
+        using _apply_t = Target<Prefix..., _result_t, typename std::decay<Args>::type...>;
+        static constexpr int _arity = sizeof...(Args);
+      };
+
+      template <typename Result, typename... Args>
+      struct signature_of<Result(Args...)> : public signature_of<Result (*)(Args...)>
+      {
+      };
+
+      template <typename Class, typename Result, typename... Args>
+      struct signature_of<Result (Class::*)(Args...)> : public signature_of<Result (*)(Args...)>
+      {
+      };
+
+      template <typename Class, typename Result, typename... Args>
+      struct signature_of<Result (Class::*)(Args...) const> : public signature_of<Result (*)(Args...)>
+      {
+      };
+
+      template <typename Callable, typename Result, typename... Args>
+      struct scalar_function
+      {
+        static void call(sqlite3_context* context, int, sqlite3_value** argv)
+        {
+          auto& function = *static_cast<Callable*>(sqlite3_user_data(context));
+          try
+          {
+            function_result<Result>::template call<Callable, Args...>(
+                context, function, argv, ::sqlpp::detail::make_index_sequence<sizeof...(Args)>{});
+          }
+          catch (const std::bad_alloc&)
+          {
+            sqlite3_result_error_nomem(context);
+          }
+          catch (const std::exception& e)
+          {
+            sqlite3_result_error(context, e.what(), -1);
+          }
+          catch (...)
+          {
+            // nothing may unwind through sqlite3's C frames
+            sqlite3_result_error(context, "unknown exception", -1);
+          }
+        }
+
+        static void destroy(void* function)
+        {
+          delete static_cast<Callable*>(function);
+        }
+      };
+
+      template <typename Callable>
+      using scalar_function_t =
+          typename signature_of<Callable>::template _apply_t<scalar_function, Callable>;
+
+      // Per-group state of aggregates, allocated by sqlite3_aggregate_context (which zeroes the memory initially).
+      // The aggregate object is constructed in place on first use, so no heap allocation happens per group.
+      template <typename Aggregate>
+      struct aggregate_state
+      {
+        bool constructed;
+        typename std::aligned_storage<sizeof(Aggregate), alignof(Aggregate)>::type storage;
+
+        Aggregate& get()
+        {
+          return *reinterpret_cast<Aggregate*>(&storage);
+        }
+      };
+
+      template <typename Aggregate, typename StepResult, typename... Args>
+      struct aggregate_function
+      {
+        static_assert(alignof(Aggregate) <= 8, "Sqlite3: aggregate_context memory is only guaranteed to be 8-byte aligned");
+        using _state_t = aggregate_state<Aggregate>;
+        using _index_t = ::sqlpp::detail::make_index_sequence<sizeof...(Args)>;
+
+        struct destroy_guard
+        {
+          _state_t* state;
+          ~destroy_guard()
+          {
+            state->get().~Aggregate();
+            state->constructed = false;
+          }
+        };
+
+        static Aggregate* get(sqlite3_context* context)
+        {
+          auto state = static_cast<_state_t*>(sqlite3_aggregate_context(context, sizeof(_state_t)));
+          if (!state)
+          {
+            return nullptr;
+          }
+          if (not state->constructed)
+          {
+            new (&state->storage) Aggregate();
+            state->constructed = true;
+          }
+          return &state->get();
+        }
+
+        template <typename Result>
+        static void set_result(sqlite3_context* context, const Result& result)
+        {
+          function_value<typename std::decay<Result>::type>::set(context, result);
+        }
+
+        template <size_t... Is>
+        static void call_step(Aggregate& aggregate, sqlite3_value** argv, const ::sqlpp::detail::index_sequence<Is...>&)
+        {
+          aggregate.step(function_value<Args>::get(argv[Is])...);
+        }
+
+        template <size_t... Is>
+        static void call_inverse(Aggregate& aggregate,
+                                 sqlite3_value** argv,
+                                 const ::sqlpp::detail::index_sequence<Is...>&)
+        {
+          aggregate.inverse(function_value<Args>::get(argv[Is])...);
+        }
+
+        static void step(sqlite3_context* context, int, sqlite3_value** argv)
+        {
+          try
+          {
+            if (auto aggregate = get(context))
+              call_step(*aggregate, argv, _index_t{});
+            else
+              sqlite3_result_error_nomem(context);
+          }
+          catch (const std::bad_alloc&)
+          {
+            sqlite3_result_error_nomem(context);
+          }
+          catch (const std::exception& e)
+          {
+            sqlite3_result_error(context, e.what(), -1);
+          }
+          catch (...)
+          {
+            sqlite3_result_error(context, "unknown exception", -1);
+          }
+        }
+
+        static void inverse(sqlite3_context* context, int, sqlite3_value** argv)
+        {
+          try
+          {
+            if (auto aggregate = get(context))
+              call_inverse(*aggregate, argv, _index_t{});
+            else
+              sqlite3_result_error_nomem(context);
+          }
+          catch (const std::bad_alloc&)
+          {
+            sqlite3_result_error_nomem(context);
+          }
+          catch (const std::exception& e)
+          {
+            sqlite3_result_error(context, e.what(), -1);
+          }
+          catch (...)
+          {
+            sqlite3_result_error(context, "unknown exception", -1);
+          }
+        }
+
+        static void value(sqlite3_context* context)
+        {
+          try
+          {
+            if (auto aggregate = get(context))
+              set_result(context, aggregate->value());
+            else
+              sqlite3_result_error_nomem(context);
+          }
+          catch (const std::bad_alloc&)
+          {
+            sqlite3_result_error_nomem(context);
+          }
+          catch (const std::exception& e)
+          {
+            sqlite3_result_error(context, e.what(), -1);
+          }
+          catch (...)
+          {
+            sqlite3_result_error(context, "unknown exception", -1);
+          }
+        }
+
+        static void final(sqlite3_context* context)
+        {
+          try
+          {
+            // no memory is allocated if there were no rows at all
+            auto state = static_cast<_state_t*>(sqlite3_aggregate_context(context, 0));
+            if (state and state->constructed)
+            {
+              destroy_guard guard{state};
+              set_result(context, state->get().final());
+            }
+            else
+            {
+              Aggregate aggregate;
+              set_result(context, aggregate.final());
+            }
+          }
+          catch (const std::bad_alloc&)
+          {
+            sqlite3_result_error_nomem(context);
+          }
+          catch (const std::exception& e)
+          {
+            sqlite3_result_error(context, e.what(), -1);
+          }
+          catch (...)
+          {
+            sqlite3_result_error(context, "unknown exception", -1);
+          }
+        }
+      };
+
+      template <typename Aggregate>
+      using aggregate_function_t =
+          typename signature_of<decltype(&Aggregate::step)>::template _apply_t<aggregate_function, Aggregate>;
+    }  // namespace detail
+  }    // namespace sqlite3
+}  // namespace sqlpp
+
+#endif
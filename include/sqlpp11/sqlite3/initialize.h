@@ -0,0 +1,67 @@
+/*
+ * Copyright (c) 2013 - 2016, Roland Bock
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ *   Redistributions of source code must retain the above copyright notice, this
+ *   list of conditions and the following disclaimer.
+ *
+ *   Redistributions in binary form must reproduce the above copyright notice, this
+ *   list of conditions and the following disclaimer in the documentation and/or
+ *   other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON
+ * ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef SQLPP_SQLITE3_INITIALIZE_H
+#define SQLPP_SQLITE3_INITIALIZE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <sqlpp11/sqlite3/export.h>
+
+namespace sqlpp
+{
+  namespace sqlite3
+  {
+    //! process-wide settings, see initialize()
+    struct global_config
+    {
+      //! replace the system malloc used by sqlite3 by a thread-caching slab allocator (SQLITE_CONFIG_MALLOC)
+      bool slab_allocator = false;
+      //! number of free blocks per size class each thread keeps before returning them to the shared pool
+      size_t thread_cache_blocks = 64;
+    };
+
+    //! statistics of the slab allocator (all zero unless it is installed)
+    struct allocator_stats
+    {
+      uint64_t allocations = 0;        // total number of allocations
+      uint64_t frees = 0;              // total number of frees
+      int64_t bytes_in_use = 0;        // currently allocated, in rounded up block sizes
+      uint64_t large_allocations = 0;  // too large for a slab, passed on to the system malloc
+      uint64_t thread_cache_hits = 0;  // small allocations served from the calling thread's cache
+      uint64_t slab_bytes = 0;         // memory reserved from the system for slabs
+    };
+
+    //! configure and initialize sqlite3 for this process.
+    // sqlite3 accepts global configuration only before it is first used, so call this before opening any
+    // connection. Throws sqlpp::exception otherwise.
+    SQLPP11_SQLITE3_EXPORT void initialize(const global_config& config = global_config{});
+
+    SQLPP11_SQLITE3_EXPORT allocator_stats allocator_statistics();
+  }  // namespace sqlite3
+}  // namespace sqlpp
+
+#endif
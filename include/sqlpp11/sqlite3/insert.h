@@ -0,0 +1,74 @@
+/*
+ * Copyright (c) 2013 - 2015, Roland Bock
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ *   Redistributions of source code must retain the above copyright notice, this
+ *   list of conditions and the following disclaimer.
+ *
+ *   Redistributions in binary form must reproduce the above copyright notice, this
+ *   list of conditions and the following disclaimer in the documentation and/or
+ *   other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON
+ * ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef SQLPP_SQLITE3_INSERT_H
+#define SQLPP_SQLITE3_INSERT_H
+
+#include <sqlpp11/insert.h>
+#include <sqlpp11/insert_value_list.h>
+#include <sqlpp11/into.h>
+#include <sqlpp11/sqlite3/on_conflict.h>
+#include <sqlpp11/sqlite3/returning.h>
+#include <sqlpp11/statement.h>
+
+namespace sqlpp
+{
+  namespace sqlite3
+  {
+    // insert statements with sqlite3 specific extensions, e.g.
+    //   sqlite3::insert_into(tab).set(...).on_conflict(tab.id).do_update(tab.counter = tab.counter + 1)
+    //   sqlite3::insert_into(tab).set(...).returning(tab.id, tab.created)
+    template <typename Database>
+    using blank_insert_t =
+        statement_t<Database, insert_t, no_into_t, no_insert_value_list_t, no_on_conflict_t, no_returning_t>;
+
+    inline auto insert() -> blank_insert_t<void>
+    {
+      return {blank_insert_t<void>()};
+    }
+
+    template <typename Table>
+    constexpr auto insert_into(Table table) -> decltype(blank_insert_t<void>().into(table))
+    {
+      return {blank_insert_t<void>().into(table)};
+    }
+
+    template <typename Database>
+    constexpr auto dynamic_insert(const Database&) -> decltype(blank_insert_t<Database>())
+    {
+      return {blank_insert_t<Database>()};
+    }
+
+    template <typename Database, typename Table>
+    constexpr auto dynamic_insert_into(const Database&, Table table)
+        -> decltype(blank_insert_t<Database>().into(table))
+    {
+      return {blank_insert_t<Database>().into(table)};
+    }
+  }  // namespace sqlite3
+}  // namespace sqlpp
+
+#endif
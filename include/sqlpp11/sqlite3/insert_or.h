@@ -33,6 +33,7 @@
 #include <sqlpp11/noop.h>
 #include <sqlpp11/parameter_list.h>
 #include <sqlpp11/prepared_insert.h>
+#include <sqlpp11/sqlite3/returning.h>
 #include <sqlpp11/statement.h>
 #include <sqlpp11/type_traits.h>
 
@@ -81,7 +82,7 @@ namespace sqlpp
 
     template <typename Database, typename InsertOrAlternative>
     using blank_insert_or_t =
-        statement_t<Database, insert_or_t<InsertOrAlternative>, no_into_t, no_insert_value_list_t>;
+        statement_t<Database, insert_or_t<InsertOrAlternative>, no_into_t, no_insert_value_list_t, no_returning_t>;
 
     template <typename Database>
     using blank_insert_or_replace_t = blank_insert_or_t<Database, insert_or_replace_name_t>;
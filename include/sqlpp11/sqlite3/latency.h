@@ -0,0 +1,123 @@
+/*
+ * Copyright (c) 2013 - 2016, Roland Bock
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ *   Redistributions of source code must retain the above copyright notice, this
+ *   list of conditions and the following disclaimer.
+ *
+ *   Redistributions in binary form must reproduce the above copyright notice, this
+ *   list of conditions and the following disclaimer in the documentation and/or
+ *   other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON
+ * ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef SQLPP_SQLITE3_LATENCY_H
+#define SQLPP_SQLITE3_LATENCY_H
+
+#include <cstdint>
+#include <map>
+#include <sqlpp11/sqlite3/export.h>
+#include <string>
+#include <vector>
+
+#ifdef _MSC_VER
+#pragma warning(push)
+#pragma warning(disable : 4251)
+#endif
+
+namespace sqlpp
+{
+  namespace sqlite3
+  {
+    //! HDR-style histogram of durations in nanoseconds.
+    // Buckets grow with the value, so that every recorded value is off by less than 1/16 (6.25%) of itself. Values
+    // beyond 2^40 ns (about 18 minutes) are counted in the last bucket. Not thread safe.
+    class SQLPP11_SQLITE3_EXPORT latency_histogram
+    {
+      std::vector<uint64_t> _buckets;  // allocated by the first record()
+      uint64_t _count = 0;
+      uint64_t _sum = 0;
+      uint64_t _min = 0;
+      uint64_t _max = 0;
+
+    public:
+      void record(uint64_t nanoseconds);
+      void merge(const latency_histogram& other);
+
+      uint64_t count() const
+      {
+        return _count;
+      }
+
+      uint64_t sum() const
+      {
+        return _sum;
+      }
+
+      uint64_t min() const
+      {
+        return _min;
+      }
+
+      uint64_t max() const
+      {
+        return _max;
+      }
+
+      double mean() const
+      {
+        return _count ? static_cast<double>(_sum) / static_cast<double>(_count) : 0.0;
+      }
+
+      //! smallest value such that percent of the recorded values are not larger (within the bucket precision)
+      uint64_t percentile(double percent) const;
+
+      //! {"count":...,"min":...,"max":...,"mean":...,"p50":...,"p90":...,"p99":...,"p999":...,
+      //!  "buckets":[[lowest value of the bucket,count],...]}, empty buckets are left out
+      std::string to_json() const;
+    };
+
+    //! where the time of running a statement is spent
+    struct SQLPP11_SQLITE3_EXPORT statement_latency
+    {
+      latency_histogram prepare;  // sqlite3_prepare_v2/v3
+      latency_histogram bind;     // per parameter, converting and binding it
+      latency_histogram step;     // per sqlite3_step, i.e. per row of a result
+      latency_histogram decode;   // per column of a result row, reading and converting it
+      latency_histogram reset;    // sqlite3_reset before running a prepared statement again
+
+      void merge(const statement_latency& other);
+
+      //! {"prepare":{...},"bind":{...},"step":{...},"decode":{...},"reset":{...}}
+      std::string to_json() const;
+    };
+
+    //! latencies per statement text, see connection::latency()
+    using latency_report = std::map<std::string, statement_latency>;
+
+    //! add the latencies of from to into, e.g. to aggregate the reports of several connections
+    SQLPP11_SQLITE3_EXPORT void merge(latency_report& into, const latency_report& from);
+
+    //! {"<statement>":{...},...}
+    SQLPP11_SQLITE3_EXPORT std::string to_json(const latency_report& report);
+  }  // namespace sqlite3
+}  // namespace sqlpp
+
+#ifdef _MSC_VER
+#pragma warning(pop)
+#endif
+
+#endif
@@ -0,0 +1,113 @@
+/*
+ * Copyright (c) 2015 - 2016, Roland Bock
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ *  * Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ * LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE
+ * OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ * OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef SQLPP_SQLITE3_LOGGER_H
+#define SQLPP_SQLITE3_LOGGER_H
+
+#include <chrono>
+#include <iosfwd>
+#include <memory>
+#include <sqlpp11/sqlite3/export.h>
+#include <string>
+
+#ifdef _MSC_VER
+#pragma warning(push)
+#pragma warning(disable : 4251)
+#endif
+
+namespace sqlpp
+{
+  namespace sqlite3
+  {
+    enum class log_level
+    {
+      debug,    // only produced if connection_config::debug is set
+      warning,
+      error,
+    };
+
+    //! a diagnostic message plus the fields it concerns
+    struct log_record
+    {
+      log_level level = log_level::debug;
+      std::string message;
+      const void* statement = nullptr;  // handle of the prepared statement, if any
+      int index = -1;                   // parameter or column index, if any
+      std::chrono::microseconds duration = std::chrono::microseconds(-1);  // if measured
+
+      log_record() = default;
+      log_record(log_level level_, std::string message_, const void* statement_ = nullptr, int index_ = -1)
+          : level(level_), message(std::move(message_)), statement(statement_), index(index_)
+      {
+      }
+    };
+
+    //! receives the diagnostics of the connector, see connection_config::log.
+    // Called by the threads using connections, possibly concurrently.
+    class SQLPP11_SQLITE3_EXPORT logger
+    {
+    public:
+      virtual ~logger() = default;
+      virtual void log(const log_record& record) = 0;
+    };
+
+    //! formats records into a stream in a background thread, so that logging threads neither wait for the stream nor
+    // for each other (beyond appending to a buffer). The stream is flushed once per batch of records.
+    class SQLPP11_SQLITE3_EXPORT async_logger : public logger
+    {
+    public:
+      struct state;
+
+      //! out must outlive the logger
+      explicit async_logger(std::ostream& out);
+      async_logger(const async_logger&) = delete;
+      async_logger(async_logger&&) = delete;
+      async_logger& operator=(const async_logger&) = delete;
+      async_logger& operator=(async_logger&&) = delete;
+      //! writes the remaining records
+      ~async_logger();
+
+      void log(const log_record& record) override;
+
+      //! wait until every record logged so far has been written
+      void flush();
+
+    private:
+      std::unique_ptr<state> _state;
+    };
+
+    //! one line per record, e.g. "Sqlite3 debug: binding integral parameter 7 [statement=0x1234 index=1]"
+    SQLPP11_SQLITE3_EXPORT std::string format(const log_record& record);
+
+    //! async_logger writing to std::cerr, used by connections without a logger of their own
+    SQLPP11_SQLITE3_EXPORT std::shared_ptr<logger> default_logger();
+  }  // namespace sqlite3
+}  // namespace sqlpp
+
+#ifdef _MSC_VER
+#pragma warning(pop)
+#endif
+
+#endif
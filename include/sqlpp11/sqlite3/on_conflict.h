@@ -0,0 +1,436 @@
+/*
+ * Copyright (c) 2013 - 2015, Roland Bock
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ *   Redistributions of source code must retain the above copyright notice, this
+ *   list of conditions and the following disclaimer.
+ *
+ *   Redistributions in binary form must reproduce the above copyright notice, this
+ *   list of conditions and the following disclaimer in the documentation and/or
+ *   other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON
+ * ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef SQLPP_SQLITE3_ON_CONFLICT_H
+#define SQLPP_SQLITE3_ON_CONFLICT_H
+
+#ifdef SQLPP_USE_SQLCIPHER
+#include <sqlcipher/sqlite3.h>
+#else
+#include <sqlite3.h>
+#endif
+#include <sqlpp11/data_types.h>
+#include <sqlpp11/detail/type_vector.h>
+#include <sqlpp11/interpret_tuple.h>
+#include <sqlpp11/logic.h>
+#include <sqlpp11/no_data.h>
+#include <sqlpp11/policy_update.h>
+#include <sqlpp11/portable_static_assert.h>
+#include <sqlpp11/serialize.h>
+#include <sqlpp11/simple_column.h>
+#include <sqlpp11/type_traits.h>
+#include <sqlpp11/wrong.h>
+#include <tuple>
+
+namespace sqlpp
+{
+  namespace sqlite3
+  {
+    SQLPP_PORTABLE_STATIC_ASSERT(assert_on_conflict_action_t,
+                                 "Sqlite3: on_conflict() requires do_nothing() or do_update()");
+
+    // conflict target
+    template <typename... Columns>
+    struct on_conflict_data_t
+    {
+      on_conflict_data_t(Columns... columns) : _columns(simple_column(columns)...)
+      {
+      }
+
+      on_conflict_data_t(const on_conflict_data_t&) = default;
+      on_conflict_data_t(on_conflict_data_t&&) = default;
+      on_conflict_data_t& operator=(const on_conflict_data_t&) = default;
+      on_conflict_data_t& operator=(on_conflict_data_t&&) = default;
+      ~on_conflict_data_t() = default;
+
+      std::tuple<simple_column_t<Columns>...> _columns;
+    };
+
+    // ON CONFLICT ... DO NOTHING
+    template <typename... Columns>
+    struct on_conflict_do_nothing_data_t
+    {
+      on_conflict_do_nothing_data_t(on_conflict_data_t<Columns...> on_conflict) : _on_conflict(on_conflict)
+      {
+      }
+
+      on_conflict_do_nothing_data_t(const on_conflict_do_nothing_data_t&) = default;
+      on_conflict_do_nothing_data_t(on_conflict_do_nothing_data_t&&) = default;
+      on_conflict_do_nothing_data_t& operator=(const on_conflict_do_nothing_data_t&) = default;
+      on_conflict_do_nothing_data_t& operator=(on_conflict_do_nothing_data_t&&) = default;
+      ~on_conflict_do_nothing_data_t() = default;
+
+      on_conflict_data_t<Columns...> _on_conflict;
+    };
+
+    template <typename... Columns>
+    struct on_conflict_do_nothing_t
+    {
+      using _traits = make_traits<no_value_t>;
+      using _nodes = ::sqlpp::detail::type_vector<Columns...>;
+
+      using _data_t = on_conflict_do_nothing_data_t<Columns...>;
+
+      template <typename Policies>
+      struct _impl_t
+      {
+        _impl_t() = default;
+        _impl_t(const _data_t& data) : _data(data)
+        {
+        }
+
+        _data_t _data;
+      };
+
+      template <typename Policies>
+      struct _base_t
+      {
+        using _data_t = on_conflict_do_nothing_data_t<Columns...>;
+
+        template <typename... Args>
+        _base_t(Args&&... args) : on_conflict_do_nothing{std::forward<Args>(args)...}
+        {
+        }
+
+        _impl_t<Policies> on_conflict_do_nothing;
+        _impl_t<Policies>& operator()()
+        {
+          return on_conflict_do_nothing;
+        }
+        const _impl_t<Policies>& operator()() const
+        {
+          return on_conflict_do_nothing;
+        }
+
+        template <typename T>
+        static auto _get_member(T t) -> decltype(t.on_conflict_do_nothing)
+        {
+          return t.on_conflict_do_nothing;
+        }
+
+        using _consistency_check = consistent_t;
+      };
+    };
+
+    // ON CONFLICT ... DO UPDATE SET ...
+    template <typename OnConflictData, typename... Assignments>
+    struct on_conflict_do_update_data_t
+    {
+      on_conflict_do_update_data_t(OnConflictData on_conflict, Assignments... assignments)
+          : _on_conflict(on_conflict), _assignments(assignments...)
+      {
+      }
+
+      on_conflict_do_update_data_t(const on_conflict_do_update_data_t&) = default;
+      on_conflict_do_update_data_t(on_conflict_do_update_data_t&&) = default;
+      on_conflict_do_update_data_t& operator=(const on_conflict_do_update_data_t&) = default;
+      on_conflict_do_update_data_t& operator=(on_conflict_do_update_data_t&&) = default;
+      ~on_conflict_do_update_data_t() = default;
+
+      OnConflictData _on_conflict;
+      std::tuple<Assignments...> _assignments;
+    };
+
+    template <typename OnConflictData, typename... Assignments>
+    struct on_conflict_do_update_t
+    {
+      using _traits = make_traits<no_value_t>;
+      using _nodes = ::sqlpp::detail::type_vector<Assignments...>;
+
+      using _data_t = on_conflict_do_update_data_t<OnConflictData, Assignments...>;
+
+      template <typename Policies>
+      struct _impl_t
+      {
+        _impl_t() = default;
+        _impl_t(const _data_t& data) : _data(data)
+        {
+        }
+
+        _data_t _data;
+      };
+
+      template <typename Policies>
+      struct _base_t
+      {
+        using _data_t = on_conflict_do_update_data_t<OnConflictData, Assignments...>;
+
+        template <typename... Args>
+        _base_t(Args&&... args) : on_conflict_do_update{std::forward<Args>(args)...}
+        {
+        }
+
+        _impl_t<Policies> on_conflict_do_update;
+        _impl_t<Policies>& operator()()
+        {
+          return on_conflict_do_update;
+        }
+        const _impl_t<Policies>& operator()() const
+        {
+          return on_conflict_do_update;
+        }
+
+        template <typename T>
+        static auto _get_member(T t) -> decltype(t.on_conflict_do_update)
+        {
+          return t.on_conflict_do_update;
+        }
+
+        using _consistency_check = consistent_t;
+      };
+    };
+
+    template <typename... Columns>
+    struct on_conflict_t
+    {
+      using _traits = make_traits<no_value_t>;
+      using _nodes = ::sqlpp::detail::type_vector<Columns...>;
+
+      using _data_t = on_conflict_data_t<Columns...>;
+
+      template <typename Policies>
+      struct _impl_t
+      {
+        _impl_t() = default;
+        _impl_t(const _data_t& data) : _data(data)
+        {
+        }
+
+        _data_t _data;
+      };
+
+      template <typename Policies>
+      struct _base_t
+      {
+        using _data_t = on_conflict_data_t<Columns...>;
+
+        template <typename... Args>
+        _base_t(Args&&... args) : on_conflict{std::forward<Args>(args)...}
+        {
+        }
+
+        _impl_t<Policies> on_conflict;
+        _impl_t<Policies>& operator()()
+        {
+          return on_conflict;
+        }
+        const _impl_t<Policies>& operator()() const
+        {
+          return on_conflict;
+        }
+
+        template <typename T>
+        static auto _get_member(T t) -> decltype(t.on_conflict)
+        {
+          return t.on_conflict;
+        }
+
+        template <typename Check, typename T>
+        using _new_statement_t = new_statement_t<Check, Policies, on_conflict_t, T>;
+
+        using _consistency_check = assert_on_conflict_action_t;
+
+        auto do_nothing() const -> _new_statement_t<consistent_t, on_conflict_do_nothing_t<Columns...>>
+        {
+          return {static_cast<const derived_statement_t<Policies>&>(*this),
+                  on_conflict_do_nothing_data_t<Columns...>{on_conflict._data}};
+        }
+
+        template <typename... Assignments>
+        auto do_update(Assignments... assignments) const
+            -> _new_statement_t<consistent_t, on_conflict_do_update_t<_data_t, Assignments...>>
+        {
+          static_assert(sizeof...(Columns) > 0, "Sqlite3: do_update() requires a conflict target in on_conflict()");
+          static_assert(sizeof...(Assignments) > 0, "Sqlite3: do_update() requires at least one assignment");
+          static_assert(logic::all_t<is_assignment_t<Assignments>::value...>::value,
+                        "Sqlite3: at least one argument is not an assignment in do_update()");
+          static_assert(logic::none_t<must_not_update_t<typename Assignments::_lhs_t>::value...>::value,
+                        "Sqlite3: at least one assignment in do_update() is prohibited by its column definition");
+
+          return {static_cast<const derived_statement_t<Policies>&>(*this),
+                  on_conflict_do_update_data_t<_data_t, Assignments...>{on_conflict._data, assignments...}};
+        }
+      };
+    };
+
+    struct no_on_conflict_t
+    {
+      using _traits = make_traits<no_value_t, tag::is_noop>;
+      using _nodes = ::sqlpp::detail::type_vector<>;
+
+      using _data_t = no_data_t;
+
+      template <typename Policies>
+      struct _impl_t
+      {
+        _impl_t() = default;
+        _impl_t(const _data_t& data) : _data(data)
+        {
+        }
+
+        _data_t _data;
+      };
+
+      template <typename Policies>
+      struct _base_t
+      {
+        using _data_t = no_data_t;
+
+        template <typename... Args>
+        _base_t(Args&&... args) : no_on_conflict{std::forward<Args>(args)...}
+        {
+        }
+
+        _impl_t<Policies> no_on_conflict;
+        _impl_t<Policies>& operator()()
+        {
+          return no_on_conflict;
+        }
+        const _impl_t<Policies>& operator()() const
+        {
+          return no_on_conflict;
+        }
+
+        template <typename T>
+        static auto _get_member(T t) -> decltype(t.no_on_conflict)
+        {
+          return t.no_on_conflict;
+        }
+
+        template <typename Check, typename T>
+        using _new_statement_t = new_statement_t<Check, Policies, no_on_conflict_t, T>;
+
+        using _consistency_check = consistent_t;
+
+        //! the conflict target, i.e. the columns of a primary key or unique index (may be empty for do_nothing())
+        template <typename... Columns>
+        auto on_conflict(Columns... columns) const -> _new_statement_t<consistent_t, on_conflict_t<Columns...>>
+        {
+#if SQLITE_VERSION_NUMBER < 3024000
+          static_assert(wrong_t<Columns...>::value, "Sqlite3: No support for on_conflict() before version 3.24.0");
+#endif
+          static_assert(logic::all_t<is_column_t<Columns>::value...>::value,
+                        "Sqlite3: at least one argument is not a column in on_conflict()");
+
+          return {static_cast<const derived_statement_t<Policies>&>(*this), on_conflict_data_t<Columns...>{columns...}};
+        }
+      };
+    };
+
+    //! refers to the value that would have been inserted, for use in do_update(), e.g.
+    //   tab.counter = tab.counter + excluded(tab.counter)
+    template <typename Column>
+    struct excluded_t : public expression_operators<excluded_t<Column>, value_type_of<Column>>
+    {
+      using _traits = make_traits<value_type_of<Column>, tag::is_expression>;
+      using _nodes = ::sqlpp::detail::type_vector<>;
+      using _can_be_null = can_be_null_t<Column>;
+
+      excluded_t(Column column) : _column(column)
+      {
+      }
+
+      excluded_t(const excluded_t&) = default;
+      excluded_t(excluded_t&&) = default;
+      excluded_t& operator=(const excluded_t&) = default;
+      excluded_t& operator=(excluded_t&&) = default;
+      ~excluded_t() = default;
+
+      Column _column;
+    };
+
+    template <typename Column>
+    auto excluded(Column column) -> excluded_t<Column>
+    {
+      static_assert(is_column_t<Column>::value, "Sqlite3: excluded() requires a column");
+      return {column};
+    }
+  }  // namespace sqlite3
+
+  template <typename Context, typename... Columns>
+  struct serializer_t<Context, sqlite3::on_conflict_data_t<Columns...>>
+  {
+    using _serialize_check = serialize_check_of<Context, Columns...>;
+    using T = sqlite3::on_conflict_data_t<Columns...>;
+
+    static Context& _(const T& t, Context& context)
+    {
+      context << " ON CONFLICT";
+      if (sizeof...(Columns))
+      {
+        context << " (";
+        interpret_tuple(t._columns, ", ", context);
+        context << ")";
+      }
+      return context;
+    }
+  };
+
+  template <typename Context, typename... Columns>
+  struct serializer_t<Context, sqlite3::on_conflict_do_nothing_data_t<Columns...>>
+  {
+    using _serialize_check = serialize_check_of<Context, Columns...>;
+    using T = sqlite3::on_conflict_do_nothing_data_t<Columns...>;
+
+    static Context& _(const T& t, Context& context)
+    {
+      serialize(t._on_conflict, context);
+      context << " DO NOTHING";
+      return context;
+    }
+  };
+
+  template <typename Context, typename OnConflictData, typename... Assignments>
+  struct serializer_t<Context, sqlite3::on_conflict_do_update_data_t<OnConflictData, Assignments...>>
+  {
+    using _serialize_check = serialize_check_of<Context, OnConflictData, Assignments...>;
+    using T = sqlite3::on_conflict_do_update_data_t<OnConflictData, Assignments...>;
+
+    static Context& _(const T& t, Context& context)
+    {
+      serialize(t._on_conflict, context);
+      context << " DO UPDATE SET ";
+      interpret_tuple(t._assignments, ", ", context);
+      return context;
+    }
+  };
+
+  template <typename Context, typename Column>
+  struct serializer_t<Context, sqlite3::excluded_t<Column>>
+  {
+    using _serialize_check = serialize_check_of<Context, Column>;
+    using T = sqlite3::excluded_t<Column>;
+
+    static Context& _(const T& t, Context& context)
+    {
+      context << "excluded.";
+      serialize(simple_column(t._column), context);
+      return context;
+    }
+  };
+}  // namespace sqlpp
+
+#endif
@@ -0,0 +1,132 @@
+/*
+ * Copyright (c) 2015 - 2016, Roland Bock
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ *  * Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ * LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE
+ * OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ * OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef SQLPP_SQLITE3_PARALLEL_SELECT_H
+#define SQLPP_SQLITE3_PARALLEL_SELECT_H
+
+#include <chrono>
+#include <cstdint>
+#include <exception>
+#include <memory>
+#include <sqlpp11/sqlite3/connection.h>
+#include <sqlpp11/sqlite3/connection_config.h>
+#include <sqlpp11/sqlite3/export.h>
+#include <string>
+#include <thread>
+#include <vector>
+
+#ifdef _MSC_VER
+#pragma warning(push)
+#pragma warning(disable : 4251)
+#endif
+
+namespace sqlpp
+{
+  namespace sqlite3
+  {
+    //! rowids first to last (inclusive)
+    struct rowid_range
+    {
+      int64_t first;
+      int64_t last;
+    };
+
+    //! split the rowids of table into up to count disjoint ranges of equal width, based on min(rowid) and
+    // max(rowid). Returns no ranges for an empty table.
+    SQLPP11_SQLITE3_EXPORT std::vector<rowid_range> split_rowid_range(connection& db,
+                                                                        const std::string& table,
+                                                                        size_t count);
+
+    namespace detail
+    {
+      //! open count connections, each with a read transaction on the same state of the database.
+      // If sqlite3 supports snapshots, the readers open the snapshot of the first one. Otherwise writers are held off
+      // by an immediate transaction on a separate connection (waiting up to lock_timeout for it) while the readers
+      // start their transactions, unless the config is read only.
+      SQLPP11_SQLITE3_EXPORT std::vector<std::unique_ptr<connection>> open_consistent_readers(
+          const connection_config& config,
+          size_t count,
+          std::chrono::milliseconds lock_timeout);
+    }  // namespace detail
+
+    //! run an aggregation over a rowid table on several connections in parallel.
+    // The rowids of table are split into up to parallelism ranges, query(connection&, rowid_range) is called for each
+    // range in a thread of its own and must restrict itself to the range, e.g. by
+    //   where(tab.id >= range.first and tab.id <= range.last)
+    // All queries see the same state of the database. The partial results are merged in rowid order by
+    // reduce(Result, Result). config must refer to a database that can be opened repeatedly (e.g. a file, ideally in
+    // WAL mode, so that writers are not blocked while the queries run).
+    template <typename Result, typename Query, typename Reducer>
+    Result parallel_select(const connection_config& config,
+                           const std::string& table,
+                           size_t parallelism,
+                           Query query,
+                           Result initial,
+                           Reducer reduce,
+                           std::chrono::milliseconds lock_timeout = std::chrono::milliseconds(10000))
+    {
+      auto readers = detail::open_consistent_readers(config, parallelism ? parallelism : 1, lock_timeout);
+      const auto ranges = split_rowid_range(*readers.front(), table, readers.size());
+
+      std::vector<Result> partials(ranges.size(), initial);
+      std::vector<std::exception_ptr> errors(ranges.size());
+      std::vector<std::thread> threads;
+      threads.reserve(ranges.size());
+      for (size_t i = 0; i < ranges.size(); ++i)
+      {
+        threads.emplace_back([&, i]() {
+          try
+          {
+            partials[i] = query(*readers[i], ranges[i]);
+          }
+          catch (...)
+          {
+            errors[i] = std::current_exception();
+          }
+        });
+      }
+      for (auto& thread : threads)
+        thread.join();
+
+      for (const auto& error : errors)
+      {
+        if (error)
+          std::rethrow_exception(error);
+      }
+      for (auto& reader : readers)
+        reader->commit_transaction();
+
+      for (auto& partial : partials)
+        initial = reduce(std::move(initial), std::move(partial));
+      return initial;
+    }
+  }  // namespace sqlite3
+}  // namespace sqlpp
+
+#ifdef _MSC_VER
+#pragma warning(pop)
+#endif
+
+#endif
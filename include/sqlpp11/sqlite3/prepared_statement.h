@@ -68,6 +68,9 @@ namespace sqlpp
         return _handle == rhs._handle;
       }
 
+      //! the statement does not change the database, e.g. a select (determined by sqlite3 when preparing)
+      bool is_read_only() const;
+
       void _reset();
       void _bind_boolean_parameter(size_t index, const signed char* value, bool is_null);
       void _bind_floating_point_parameter(size_t index, const double* value, bool is_null);
@@ -77,6 +80,10 @@ namespace sqlpp
       void _bind_date_parameter(size_t index, const ::sqlpp::chrono::day_point* value, bool is_null);
       void _bind_date_time_parameter(size_t index, const ::sqlpp::chrono::microsecond_point* value, bool is_null);
       void _bind_blob_parameter(size_t index, const std::vector<uint8_t>* value, bool is_null);
+      // the vector is bound without copying, it must stay unchanged while the statement is running
+      void _bind_carray_parameter(size_t index, const std::vector<int64_t>* value);
+      void _bind_carray_parameter(size_t index, const std::vector<double>* value);
+      void _bind_carray_parameter(size_t index, const std::vector<std::string>* value);
     };
   }  // namespace sqlite3
 }  // namespace sqlpp
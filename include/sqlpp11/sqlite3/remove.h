@@ -0,0 +1,71 @@
+/*
+ * Copyright (c) 2013 - 2015, Roland Bock
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ *   Redistributions of source code must retain the above copyright notice, this
+ *   list of conditions and the following disclaimer.
+ *
+ *   Redistributions in binary form must reproduce the above copyright notice, this
+ *   list of conditions and the following disclaimer in the documentation and/or
+ *   other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON
+ * ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef SQLPP_SQLITE3_REMOVE_H
+#define SQLPP_SQLITE3_REMOVE_H
+
+#include <sqlpp11/from.h>
+#include <sqlpp11/remove.h>
+#include <sqlpp11/sqlite3/returning.h>
+#include <sqlpp11/statement.h>
+#include <sqlpp11/using.h>
+#include <sqlpp11/where.h>
+
+namespace sqlpp
+{
+  namespace sqlite3
+  {
+    // remove statements with sqlite3 specific extensions, e.g.
+    //   sqlite3::remove_from(tab).where(...).returning(tab.id)
+    template <typename Database>
+    using blank_remove_t = statement_t<Database, remove_t, no_from_t, no_using_t, no_where_t<true>, no_returning_t>;
+
+    inline auto remove() -> blank_remove_t<void>
+    {
+      return {blank_remove_t<void>()};
+    }
+
+    template <typename Table>
+    auto remove_from(Table table) -> decltype(blank_remove_t<void>().from(table))
+    {
+      return {blank_remove_t<void>().from(table)};
+    }
+
+    template <typename Database>
+    auto dynamic_remove(const Database&) -> decltype(blank_remove_t<Database>())
+    {
+      return {blank_remove_t<Database>()};
+    }
+
+    template <typename Database, typename Table>
+    auto dynamic_remove_from(const Database&, Table table) -> decltype(blank_remove_t<Database>().from(table))
+    {
+      return {blank_remove_t<Database>().from(table)};
+    }
+  }  // namespace sqlite3
+}  // namespace sqlpp
+
+#endif
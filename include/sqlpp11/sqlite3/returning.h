@@ -0,0 +1,201 @@
+/*
+ * Copyright (c) 2013 - 2015, Roland Bock
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ *   Redistributions of source code must retain the above copyright notice, this
+ *   list of conditions and the following disclaimer.
+ *
+ *   Redistributions in binary form must reproduce the above copyright notice, this
+ *   list of conditions and the following disclaimer in the documentation and/or
+ *   other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON
+ * ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef SQLPP_SQLITE3_RETURNING_H
+#define SQLPP_SQLITE3_RETURNING_H
+
+#ifdef SQLPP_USE_SQLCIPHER
+#include <sqlcipher/sqlite3.h>
+#else
+#include <sqlite3.h>
+#endif
+#include <sqlpp11/detail/type_vector.h>
+#include <sqlpp11/logic.h>
+#include <sqlpp11/no_data.h>
+#include <sqlpp11/policy_update.h>
+#include <sqlpp11/select_column_list.h>
+#include <sqlpp11/serialize.h>
+#include <sqlpp11/type_traits.h>
+#include <sqlpp11/wrong.h>
+
+namespace sqlpp
+{
+  namespace sqlite3
+  {
+    // The returned columns are stored like selected columns, so that results are bound exactly like select results
+    template <typename... Columns>
+    struct returning_data_t : public select_column_list_data_t<void, Columns...>
+    {
+      using _base_data_t = select_column_list_data_t<void, Columns...>;
+
+      returning_data_t(Columns... columns) : _base_data_t(columns...)
+      {
+      }
+
+      returning_data_t(const returning_data_t&) = default;
+      returning_data_t(returning_data_t&&) = default;
+      returning_data_t& operator=(const returning_data_t&) = default;
+      returning_data_t& operator=(returning_data_t&&) = default;
+      ~returning_data_t() = default;
+    };
+
+    template <typename... Columns>
+    struct returning_t
+    {
+      using _traits = make_traits<no_value_t, tag::is_return_value>;
+      using _nodes = ::sqlpp::detail::type_vector<Columns...>;
+
+      using _data_t = returning_data_t<Columns...>;
+
+      template <typename Policies>
+      struct _impl_t
+      {
+        _impl_t() = default;
+        _impl_t(const _data_t& data) : _data(data)
+        {
+        }
+
+        _data_t _data;
+      };
+
+      template <typename Policies>
+      struct _base_t
+      {
+        using _data_t = returning_data_t<Columns...>;
+
+        template <typename... Args>
+        _base_t(Args&&... args) : selected_columns{std::forward<Args>(args)...}
+        {
+        }
+
+        // named like the member of select_column_list_t, whose result methods access it
+        _impl_t<Policies> selected_columns;
+        _impl_t<Policies>& operator()()
+        {
+          return selected_columns;
+        }
+        const _impl_t<Policies>& operator()() const
+        {
+          return selected_columns;
+        }
+
+        template <typename T>
+        static auto _get_member(T t) -> decltype(t.selected_columns)
+        {
+          return t.selected_columns;
+        }
+
+        using _consistency_check = consistent_t;
+      };
+
+      // the statement is run and prepared as a select, i.e. via connection::select and connection::prepare_select
+      template <typename Statement>
+      using _result_methods_t = typename select_column_list_t<void, Columns...>::template _result_methods_t<Statement>;
+    };
+
+    struct no_returning_t
+    {
+      using _traits = make_traits<no_value_t, tag::is_noop>;
+      using _nodes = ::sqlpp::detail::type_vector<>;
+
+      using _data_t = no_data_t;
+
+      template <typename Policies>
+      struct _impl_t
+      {
+        _impl_t() = default;
+        _impl_t(const _data_t& data) : _data(data)
+        {
+        }
+
+        _data_t _data;
+      };
+
+      template <typename Policies>
+      struct _base_t
+      {
+        using _data_t = no_data_t;
+
+        template <typename... Args>
+        _base_t(Args&&... args) : no_returning{std::forward<Args>(args)...}
+        {
+        }
+
+        _impl_t<Policies> no_returning;
+        _impl_t<Policies>& operator()()
+        {
+          return no_returning;
+        }
+        const _impl_t<Policies>& operator()() const
+        {
+          return no_returning;
+        }
+
+        template <typename T>
+        static auto _get_member(T t) -> decltype(t.no_returning)
+        {
+          return t.no_returning;
+        }
+
+        template <typename Check, typename T>
+        using _new_statement_t = new_statement_t<Check, Policies, no_returning_t, T>;
+
+        using _consistency_check = consistent_t;
+
+        //! return the given columns of the inserted, updated or deleted rows, the statement then yields a result
+        // like a select
+        template <typename... Columns>
+        auto returning(Columns... columns) const -> _new_statement_t<consistent_t, returning_t<Columns...>>
+        {
+#if SQLITE_VERSION_NUMBER < 3035000
+          static_assert(wrong_t<Columns...>::value, "Sqlite3: No support for returning() before version 3.35.0");
+#endif
+          static_assert(sizeof...(Columns) > 0, "Sqlite3: returning() requires at least one column");
+          static_assert(logic::all_t<is_selectable_t<Columns>::value...>::value,
+                        "Sqlite3: at least one argument is not selectable in returning()");
+
+          return {static_cast<const derived_statement_t<Policies>&>(*this), returning_data_t<Columns...>{columns...}};
+        }
+      };
+    };
+  }  // namespace sqlite3
+
+  template <typename Context, typename... Columns>
+  struct serializer_t<Context, sqlite3::returning_data_t<Columns...>>
+  {
+    using _serialize_check = serialize_check_of<Context, Columns...>;
+    using T = sqlite3::returning_data_t<Columns...>;
+
+    static Context& _(const T& t, Context& context)
+    {
+      context << " RETURNING ";
+      serialize(static_cast<const typename T::_base_data_t&>(t), context);
+      return context;
+    }
+  };
+}  // namespace sqlpp
+
+#endif
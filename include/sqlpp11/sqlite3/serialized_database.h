@@ -0,0 +1,77 @@
+/*
+ * Copyright (c) 2013 - 2016, Roland Bock
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ *   Redistributions of source code must retain the above copyright notice, this
+ *   list of conditions and the following disclaimer.
+ *
+ *   Redistributions in binary form must reproduce the above copyright notice, this
+ *   list of conditions and the following disclaimer in the documentation and/or
+ *   other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON
+ * ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef SQLPP_SQLITE3_SERIALIZED_DATABASE_H
+#define SQLPP_SQLITE3_SERIALIZED_DATABASE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <sqlpp11/sqlite3/export.h>
+
+namespace sqlpp
+{
+  namespace sqlite3
+  {
+    class connection;
+
+    //! image of a database schema as produced by connection::serialize.
+    // The memory is allocated by sqlite3 and can be handed back to it via connection::deserialize without copying.
+    class SQLPP11_SQLITE3_EXPORT serialized_database
+    {
+      friend ::sqlpp::sqlite3::connection;
+      uint8_t* _data = nullptr;
+      size_t _size = 0;
+
+      serialized_database(uint8_t* data, size_t size);
+      uint8_t* release() noexcept;
+
+    public:
+      serialized_database() = default;
+      serialized_database(const serialized_database&) = delete;
+      serialized_database(serialized_database&& rhs) noexcept;
+      serialized_database& operator=(const serialized_database&) = delete;
+      serialized_database& operator=(serialized_database&& rhs) noexcept;
+      ~serialized_database();
+
+      const uint8_t* data() const
+      {
+        return _data;
+      }
+
+      size_t size() const
+      {
+        return _size;
+      }
+
+      bool empty() const
+      {
+        return _size == 0;
+      }
+    };
+  }  // namespace sqlite3
+}  // namespace sqlpp
+
+#endif
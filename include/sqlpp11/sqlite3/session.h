@@ -0,0 +1,136 @@
+/*
+ * Copyright (c) 2013 - 2016, Roland Bock
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ *   Redistributions of source code must retain the above copyright notice, this
+ *   list of conditions and the following disclaimer.
+ *
+ *   Redistributions in binary form must reproduce the above copyright notice, this
+ *   list of conditions and the following disclaimer in the documentation and/or
+ *   other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON
+ * ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef SQLPP_SQLITE3_SESSION_H
+#define SQLPP_SQLITE3_SESSION_H
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <sqlpp11/sqlite3/export.h>
+#include <string>
+#include <vector>
+
+#ifdef _MSC_VER
+#pragma warning(push)
+#pragma warning(disable : 4251)
+#endif
+
+struct sqlite3_session;
+
+namespace sqlpp
+{
+  namespace sqlite3
+  {
+    class connection;
+
+    //! binary changeset as produced by the sqlite3 session extension, e.g. to be shipped to a replica
+    class SQLPP11_SQLITE3_EXPORT changeset
+    {
+      std::vector<uint8_t> _data;
+
+    public:
+      changeset() = default;
+      explicit changeset(std::vector<uint8_t> data);
+      changeset(const uint8_t* data, size_t size);
+
+      const uint8_t* data() const
+      {
+        return _data.data();
+      }
+
+      size_t size() const
+      {
+        return _data.size();
+      }
+
+      bool empty() const
+      {
+        return _data.empty();
+      }
+
+      const std::vector<uint8_t>& bytes() const
+      {
+        return _data;
+      }
+    };
+
+    //! SQLITE_CHANGESET_* reasons for calling a conflict handler
+    enum class conflict_type
+    {
+      data,         // the row to update or delete exists, but has different values
+      not_found,    // the row to update or delete does not exist
+      conflict,     // the row to insert exists already
+      constraint,   // a change violates a constraint
+      foreign_key,  // foreign key violations remain after applying the changeset
+    };
+
+    //! SQLITE_CHANGESET_* answers of a conflict handler
+    enum class conflict_action
+    {
+      omit,     // skip the change
+      replace,  // apply the change anyway (only for conflict_type::data and conflict_type::conflict)
+      abort,    // roll back all changes and throw
+    };
+
+    //! called with the type of conflict and the name of the table the change belongs to
+    using conflict_handler = std::function<conflict_action(conflict_type, const std::string& table)>;
+
+    //! records changes made through a connection to the given tables (all tables if none are given) while it exists.
+    // Only changes to tables with a PRIMARY KEY are recorded. Requires the session extension, i.e. sqlite3 compiled
+    // with SQLITE_ENABLE_SESSION and SQLITE_ENABLE_PREUPDATE_HOOK, and SQLITE_ENABLE_SESSION defined when compiling
+    // this library (the CMake option SQLITE3_ENABLE_SESSION, on if sqlite3 provides the session extension).
+    class SQLPP11_SQLITE3_EXPORT change_capture
+    {
+      ::sqlite3_session* _session = nullptr;
+
+    public:
+      change_capture(connection& db, const std::vector<std::string>& tables, const std::string& schema = "main");
+      change_capture(const change_capture&) = delete;
+      change_capture(change_capture&& rhs) noexcept;
+      change_capture& operator=(const change_capture&) = delete;
+      change_capture& operator=(change_capture&& rhs) noexcept;
+      ~change_capture();
+
+      //! net changes recorded so far (e.g. a row inserted and deleted again is not contained)
+      changeset changes() const;
+
+      //! true if no changes have been recorded so far
+      bool empty() const;
+
+      ::sqlite3_session* native_handle() const
+      {
+        return _session;
+      }
+    };
+  }  // namespace sqlite3
+}  // namespace sqlpp
+
+#ifdef _MSC_VER
+#pragma warning(pop)
+#endif
+
+#endif
@@ -0,0 +1,149 @@
+/*
+ * Copyright (c) 2015 - 2016, Roland Bock
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ *  * Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ * LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE
+ * OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ * OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef SQLPP_SQLITE3_SHARED_CACHE_POOL_H
+#define SQLPP_SQLITE3_SHARED_CACHE_POOL_H
+
+#include <memory>
+#include <sqlpp11/serialize.h>
+#include <sqlpp11/sqlite3/connection.h>
+#include <sqlpp11/sqlite3/connection_config.h>
+#include <sqlpp11/sqlite3/export.h>
+
+#ifdef _MSC_VER
+#pragma warning(push)
+#pragma warning(disable : 4251)
+#endif
+
+namespace sqlpp
+{
+  namespace sqlite3
+  {
+    class shared_cache_pool;
+
+    //! a connection borrowed from a shared_cache_pool, handed back when destroyed
+    class SQLPP11_SQLITE3_EXPORT pooled_connection
+    {
+    public:
+      pooled_connection(shared_cache_pool& pool, std::unique_ptr<connection> db, bool writer);
+      pooled_connection(const pooled_connection&) = delete;
+      pooled_connection(pooled_connection&&) noexcept;
+      pooled_connection& operator=(const pooled_connection&) = delete;
+      pooled_connection& operator=(pooled_connection&&) noexcept;
+      ~pooled_connection();
+
+      connection& operator*() const
+      {
+        return *_db;
+      }
+
+      connection* operator->() const
+      {
+        return _db.get();
+      }
+
+      //! hand the connection back to the pool before destruction
+      void release();
+
+    private:
+      shared_cache_pool* _pool;
+      std::unique_ptr<connection> _db;
+      bool _writer;
+    };
+
+    //! the result of a statement run by shared_cache_pool, together with the connection it belongs to
+    template <typename Result>
+    struct routed_result
+    {
+      pooled_connection db;
+      Result result;
+    };
+
+    //! Connections to one database in shared-cache mode, for reading it from many threads without a copy per
+    // connection, e.g. a named in-memory database.
+    // There is one writer and up to max_readers readers. Readers use read_uncommitted, so they neither wait for the
+    // writer's table locks nor block it, and they see uncommitted changes. They are limited to queries
+    // (PRAGMA query_only). The in-memory database lives as long as the pool, which must outlive all borrowed
+    // connections.
+    class SQLPP11_SQLITE3_EXPORT shared_cache_pool
+    {
+    public:
+      struct state;
+
+      //! pool for the in-memory database "file:<name>?mode=memory&cache=shared"
+      shared_cache_pool(const std::string& name, size_t max_readers, bool debug = false);
+
+      //! pool for the given database, which is opened with SQLITE_OPEN_SHAREDCACHE and SQLITE_OPEN_URI
+      shared_cache_pool(connection_config config, size_t max_readers);
+      shared_cache_pool(const shared_cache_pool&) = delete;
+      shared_cache_pool(shared_cache_pool&&) = delete;
+      shared_cache_pool& operator=(const shared_cache_pool&) = delete;
+      shared_cache_pool& operator=(shared_cache_pool&&) = delete;
+      ~shared_cache_pool();
+
+      //! borrow the writer, waiting while it is in use
+      pooled_connection writer();
+
+      //! borrow a reader, waiting while max_readers are in use. Readers are opened on demand and reused.
+      pooled_connection reader();
+
+      //! number of reader connections opened so far
+      size_t open_readers() const;
+
+      //! run the statement on a reader if it leaves the database unchanged, on the writer otherwise.
+      // The classification (sqlite3_stmt_readonly) is cached per statement text, for a bounded number of texts.
+      // Writes never wait for a reader. Must not be called while holding the writer.
+      template <typename Statement>
+      auto operator()(const Statement& statement)
+          -> routed_result<decltype(std::declval<connection&>()(statement))>
+      {
+        serializer_t context(serializing_connection());
+        ::sqlpp::serialize(statement, context);
+        auto text = context.str();
+        auto db = borrow_for(text);
+        auto result = db->run_serialized(statement, std::move(text));
+        return {std::move(db), std::move(result)};
+      }
+
+    private:
+      friend class pooled_connection;
+      void give_back(std::unique_ptr<connection> db, bool writer);
+      std::unique_ptr<connection> take_reader(bool wait);
+      bool is_read_only(connection& db, const std::string& statement);
+      // a connection for serializing statements only, which is safe while it is borrowed: escaping does not use it
+      const connection& serializing_connection() const;
+      // a reader if the statement is read-only, the writer otherwise
+      pooled_connection borrow_for(const std::string& statement);
+
+      std::unique_ptr<state> _state;
+    };
+  }  // namespace sqlite3
+}  // namespace sqlpp
+
+#ifdef _MSC_VER
+#pragma warning(pop)
+#endif
+
+#endif
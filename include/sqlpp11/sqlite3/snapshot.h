@@ -0,0 +1,92 @@
+/*
+ * Copyright (c) 2013 - 2016, Roland Bock
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ *   Redistributions of source code must retain the above copyright notice, this
+ *   list of conditions and the following disclaimer.
+ *
+ *   Redistributions in binary form must reproduce the above copyright notice, this
+ *   list of conditions and the following disclaimer in the documentation and/or
+ *   other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON
+ * ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef SQLPP_SQLITE3_SNAPSHOT_H
+#define SQLPP_SQLITE3_SNAPSHOT_H
+
+#ifdef SQLPP_USE_SQLCIPHER
+#include <sqlcipher/sqlite3.h>
+#else
+#include <sqlite3.h>
+#endif
+#include <sqlpp11/sqlite3/export.h>
+#include <string>
+
+#ifdef _MSC_VER
+#pragma warning(push)
+#pragma warning(disable : 4251)
+#endif
+
+namespace sqlpp
+{
+  namespace sqlite3
+  {
+    class connection;
+
+    //! state of a WAL database as seen by a read transaction, which can be opened on other connections to the same
+    // database, so that they all read the same data.
+    // Requires sqlite3 to be compiled with SQLITE_ENABLE_SNAPSHOT (see runtime_features().snapshot), and
+    // SQLITE_ENABLE_SNAPSHOT to be defined when compiling this library (the CMake option SQLITE3_ENABLE_SNAPSHOT,
+    // on if sqlite3 provides snapshots; not needed if sqlite3 is loaded dynamically).
+    class SQLPP11_SQLITE3_EXPORT snapshot
+    {
+      ::sqlite3_snapshot* _snapshot = nullptr;
+      std::string _schema;
+
+    public:
+      //! record the state seen by the transaction open on db. If there is none, the constructor starts one and leaves
+      // it open.
+      // The snapshot remains available while a connection has a read transaction on it; once every such transaction
+      // has ended, a checkpoint may discard it.
+      snapshot(connection& db, const std::string& schema = "main");
+      snapshot(const snapshot&) = delete;
+      snapshot(snapshot&& rhs) noexcept;
+      snapshot& operator=(const snapshot&) = delete;
+      snapshot& operator=(snapshot&& rhs) noexcept;
+      ~snapshot();
+
+      //! start a read transaction on db that sees the recorded state. End it with commit_transaction().
+      // db must not be in a transaction.
+      void open(connection& db) const;
+
+      const std::string& schema() const
+      {
+        return _schema;
+      }
+
+      ::sqlite3_snapshot* native_handle() const
+      {
+        return _snapshot;
+      }
+    };
+  }  // namespace sqlite3
+}  // namespace sqlpp
+
+#ifdef _MSC_VER
+#pragma warning(pop)
+#endif
+
+#endif
@@ -27,7 +27,12 @@
 #ifndef SQLPP_SQLITE3_H
 #define SQLPP_SQLITE3_H
 
+#include <sqlpp11/sqlite3/carray.h>
 #include <sqlpp11/sqlite3/connection.h>
+#include <sqlpp11/sqlite3/insert.h>
 #include <sqlpp11/sqlite3/insert_or.h>
+#include <sqlpp11/sqlite3/remove.h>
+#include <sqlpp11/sqlite3/update.h>
+#include <sqlpp11/sqlite3/zeroblob.h>
 
 #endif
@@ -0,0 +1,91 @@
+/*
+ * Copyright (c) 2013 - 2016, Roland Bock
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ *   Redistributions of source code must retain the above copyright notice, this
+ *   list of conditions and the following disclaimer.
+ *
+ *   Redistributions in binary form must reproduce the above copyright notice, this
+ *   list of conditions and the following disclaimer in the documentation and/or
+ *   other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON
+ * ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef SQLPP_SQLITE3_STATISTICS_H
+#define SQLPP_SQLITE3_STATISTICS_H
+
+#include <cstdint>
+#include <sqlpp11/sqlite3/export.h>
+
+namespace sqlpp
+{
+  namespace sqlite3
+  {
+    //! a value that goes up and down, e.g. memory in use
+    struct status_gauge
+    {
+      int64_t current = 0;
+      int64_t highwater = 0;
+      int64_t delta = 0;  // change of current since the previous snapshot
+    };
+
+    //! a monotonically increasing count, e.g. cache hits
+    struct status_counter
+    {
+      int64_t total = 0;
+      int64_t delta = 0;  // increase since the previous snapshot
+    };
+
+    //! per connection statistics (sqlite3_db_status), see connection::stats()
+    struct connection_stats
+    {
+      status_gauge cache_used;  // bytes of page cache memory
+      status_counter cache_hit;
+      status_counter cache_miss;
+      status_counter cache_write;
+      status_counter cache_spill;
+      status_gauge lookaside_used;  // lookaside slots in use
+      status_counter lookaside_hit;
+      status_counter lookaside_miss_size;  // allocations too large for a lookaside slot
+      status_counter lookaside_miss_full;  // allocations failing because all lookaside slots were in use
+      status_gauge schema_used;            // bytes used by the schemas of all attached databases
+      status_gauge stmt_used;              // bytes used by prepared statements
+
+      //! page cache hit rate since the previous snapshot (0 if there were no page lookups)
+      double cache_hit_rate() const
+      {
+        const auto lookups = cache_hit.delta + cache_miss.delta;
+        return lookups ? static_cast<double>(cache_hit.delta) / static_cast<double>(lookups) : 0.0;
+      }
+    };
+
+    //! process-wide statistics (sqlite3_status64)
+    struct global_stats
+    {
+      status_gauge memory_used;         // bytes allocated through sqlite3's allocator
+      status_gauge malloc_count;        // number of outstanding allocations
+      status_gauge malloc_size;         // largest single allocation (highwater only)
+      status_gauge pagecache_used;      // pages used from SQLITE_CONFIG_PAGECACHE memory
+      status_gauge pagecache_overflow;  // page cache bytes that did not fit SQLITE_CONFIG_PAGECACHE memory
+      status_gauge pagecache_size;      // largest page cache allocation (highwater only)
+    };
+
+    //! take a snapshot of the process-wide statistics, deltas are relative to the previous call
+    SQLPP11_SQLITE3_EXPORT global_stats global_statistics();
+  }  // namespace sqlite3
+}  // namespace sqlpp
+
+#endif
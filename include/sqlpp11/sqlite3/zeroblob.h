@@ -0,0 +1,88 @@
+/*
+ * Copyright (c) 2013 - 2015, Roland Bock
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ *   Redistributions of source code must retain the above copyright notice, this
+ *   list of conditions and the following disclaimer.
+ *
+ *   Redistributions in binary form must reproduce the above copyright notice, this
+ *   list of conditions and the following disclaimer in the documentation and/or
+ *   other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON
+ * ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef SQLPP_SQLITE3_ZEROBLOB_H
+#define SQLPP_SQLITE3_ZEROBLOB_H
+
+#include <sqlpp11/data_types.h>
+#include <sqlpp11/detail/type_vector.h>
+#include <sqlpp11/serialize.h>
+#include <sqlpp11/type_traits.h>
+#include <sqlpp11/wrap_operand.h>
+
+namespace sqlpp
+{
+  namespace sqlite3
+  {
+    //! a blob of the given size filled with zeros, to be filled incrementally via connection::open_blob, e.g.
+    //   db(insert_into(tab).set(tab.data = sqlite3::zeroblob(size)));
+    // The size may be a parameter, so that the statement can be prepared once for any size.
+    template <typename Size>
+    struct zeroblob_t : public expression_operators<zeroblob_t<Size>, blob>
+    {
+      using _traits = make_traits<blob, tag::is_expression>;
+      using _nodes = ::sqlpp::detail::type_vector<Size>;
+      using _can_be_null = std::false_type;
+
+      zeroblob_t(Size size) : _size(size)
+      {
+      }
+
+      zeroblob_t(const zeroblob_t&) = default;
+      zeroblob_t(zeroblob_t&&) = default;
+      zeroblob_t& operator=(const zeroblob_t&) = default;
+      zeroblob_t& operator=(zeroblob_t&&) = default;
+      ~zeroblob_t() = default;
+
+      Size _size;
+    };
+
+    template <typename T>
+    auto zeroblob(T size) -> zeroblob_t<wrap_operand_t<T>>
+    {
+      static_assert(is_integral_t<wrap_operand_t<T>>::value or is_unsigned_integral_t<wrap_operand_t<T>>::value,
+                    "Sqlite3: zeroblob() requires an integral size");
+      return {size};
+    }
+  }  // namespace sqlite3
+
+  template <typename Context, typename Size>
+  struct serializer_t<Context, sqlite3::zeroblob_t<Size>>
+  {
+    using _serialize_check = serialize_check_of<Context, Size>;
+    using T = sqlite3::zeroblob_t<Size>;
+
+    static Context& _(const T& t, Context& context)
+    {
+      context << "zeroblob(";
+      serialize(t._size, context);
+      context << ")";
+      return context;
+    }
+  };
+}  // namespace sqlpp
+
+#endif
@@ -24,11 +24,12 @@
  * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
  */
 
+#include "detail/latency_timer.h"
+#include "detail/log.h"
 #include "detail/prepared_statement_handle.h"
 #include <cctype>
 #include <ciso646>
 #include <date/date.h>  // Howard Hinnant's date library
-#include <iostream>
 #include <sqlpp11/exception.h>
 #include <sqlpp11/sqlite3/bind_result.h>
 #include <vector>
@@ -48,13 +49,15 @@ namespace sqlpp
     bind_result_t::bind_result_t(const std::shared_ptr<detail::prepared_statement_handle_t>& handle) : _handle(handle)
     {
       if (_handle and _handle->debug)
-        std::cerr << "Sqlite3 debug: Constructing bind result, using handle at " << _handle.get() << std::endl;
+        detail::log_debug(*_handle, -1, "Constructing bind result");
     }
 
     void bind_result_t::_bind_boolean_result(size_t index, signed char* value, bool* is_null)
     {
       if (_handle->debug)
-        std::cerr << "Sqlite3 debug: binding boolean result " << *value << " at index: " << index << std::endl;
+        detail::log_debug(*_handle, index, "binding boolean result ", *value);
+
+      detail::phase_timer timer(_handle->latency.get(), &statement_latency::decode);
 
       *value = static_cast<signed char>(sqlite3_column_int(_handle->sqlite_statement, static_cast<int>(index)));
       *is_null = sqlite3_column_type(_handle->sqlite_statement, static_cast<int>(index)) == SQLITE_NULL;
@@ -63,7 +66,9 @@ namespace sqlpp
     void bind_result_t::_bind_floating_point_result(size_t index, double* value, bool* is_null)
     {
       if (_handle->debug)
-        std::cerr << "Sqlite3 debug: binding floating_point result " << *value << " at index: " << index << std::endl;
+        detail::log_debug(*_handle, index, "binding floating_point result ", *value);
+
+      detail::phase_timer timer(_handle->latency.get(), &statement_latency::decode);
 
       switch (sqlite3_column_type(_handle->sqlite_statement, static_cast<int>(index)))
       {
@@ -80,7 +85,9 @@ namespace sqlpp
     void bind_result_t::_bind_integral_result(size_t index, int64_t* value, bool* is_null)
     {
       if (_handle->debug)
-        std::cerr << "Sqlite3 debug: binding integral result " << *value << " at index: " << index << std::endl;
+        detail::log_debug(*_handle, index, "binding integral result ", *value);
+
+      detail::phase_timer timer(_handle->latency.get(), &statement_latency::decode);
 
       *value = sqlite3_column_int64(_handle->sqlite_statement, static_cast<int>(index));
       *is_null = sqlite3_column_type(_handle->sqlite_statement, static_cast<int>(index)) == SQLITE_NULL;
@@ -89,8 +96,9 @@ namespace sqlpp
     void bind_result_t::_bind_unsigned_integral_result(size_t index, uint64_t* value, bool* is_null)
     {
       if (_handle->debug)
-        std::cerr << "Sqlite3 debug: binding unsigned integral result " << *value << " at index: " << index
-                  << std::endl;
+        detail::log_debug(*_handle, index, "binding unsigned integral result ", *value);
+
+      detail::phase_timer timer(_handle->latency.get(), &statement_latency::decode);
 
       *value = static_cast<uint64_t>(sqlite3_column_int64(_handle->sqlite_statement, static_cast<int>(index)));
       *is_null = sqlite3_column_type(_handle->sqlite_statement, static_cast<int>(index)) == SQLITE_NULL;
@@ -99,7 +107,9 @@ namespace sqlpp
     void bind_result_t::_bind_text_result(size_t index, const char** value, size_t* len)
     {
       if (_handle->debug)
-        std::cerr << "Sqlite3 debug: binding text result at index: " << index << std::endl;
+        detail::log_debug(*_handle, index, "binding text result");
+
+      detail::phase_timer timer(_handle->latency.get(), &statement_latency::decode);
 
       *value = (reinterpret_cast<const char*>(sqlite3_column_text(_handle->sqlite_statement, static_cast<int>(index))));
       *len = sqlite3_column_bytes(_handle->sqlite_statement, static_cast<int>(index));
@@ -108,7 +118,9 @@ namespace sqlpp
     void bind_result_t::_bind_blob_result(size_t index, const uint8_t** value, size_t* len)
     {
       if (_handle->debug)
-        std::cerr << "Sqlite3 debug: binding text result at index: " << index << std::endl;
+        detail::log_debug(*_handle, index, "binding blob result");
+
+      detail::phase_timer timer(_handle->latency.get(), &statement_latency::decode);
 
       *value =
           (reinterpret_cast<const uint8_t*>(sqlite3_column_blob(_handle->sqlite_statement, static_cast<int>(index))));
@@ -148,7 +160,9 @@ namespace sqlpp
     void bind_result_t::_bind_date_result(size_t index, ::sqlpp::chrono::day_point* value, bool* is_null)
     {
       if (_handle->debug)
-        std::cerr << "Sqlite3 debug: binding date result at index: " << index << std::endl;
+        detail::log_debug(*_handle, index, "binding date result");
+
+      detail::phase_timer timer(_handle->latency.get(), &statement_latency::decode);
 
       *is_null = sqlite3_column_type(_handle->sqlite_statement, static_cast<int>(index)) == SQLITE_NULL;
       if (*is_null)
@@ -160,7 +174,7 @@ namespace sqlpp
       const auto date_string =
           reinterpret_cast<const char*>(sqlite3_column_text(_handle->sqlite_statement, static_cast<int>(index)));
       if (_handle->debug)
-        std::cerr << "Sqlite3 debug: date string: " << date_string << std::endl;
+        detail::log_debug(*_handle, index, "date string: ", date_string);
 
       if (check_digits(date_string, date_digits))
       {
@@ -170,7 +184,7 @@ namespace sqlpp
       else
       {
         if (_handle->debug)
-          std::cerr << "Sqlite3 debug: invalid date result: " << date_string << std::endl;
+          detail::log_debug(*_handle, index, "invalid date result: ", date_string);
         *value = {};
       }
     }
@@ -178,7 +192,9 @@ namespace sqlpp
     void bind_result_t::_bind_date_time_result(size_t index, ::sqlpp::chrono::microsecond_point* value, bool* is_null)
     {
       if (_handle->debug)
-        std::cerr << "Sqlite3 debug: binding date result at index: " << index << std::endl;
+        detail::log_debug(*_handle, index, "binding date_time result");
+
+      detail::phase_timer timer(_handle->latency.get(), &statement_latency::decode);
 
       *is_null = sqlite3_column_type(_handle->sqlite_statement, static_cast<int>(index)) == SQLITE_NULL;
       if (*is_null)
@@ -190,7 +206,7 @@ namespace sqlpp
       const auto date_time_string =
           reinterpret_cast<const char*>(sqlite3_column_text(_handle->sqlite_statement, static_cast<int>(index)));
       if (_handle->debug)
-        std::cerr << "Sqlite3 debug: date_time string: " << date_time_string << std::endl;
+        detail::log_debug(*_handle, index, "date_time string: ", date_time_string);
 
       if (check_digits(date_time_string, date_digits))
       {
@@ -201,7 +217,7 @@ namespace sqlpp
       else
       {
         if (_handle->debug)
-          std::cerr << "Sqlite3 debug: invalid date_time result: " << date_time_string << std::endl;
+          detail::log_debug(*_handle, index, "invalid date_time result: ", date_time_string);
         *value = {};
 
         return;
@@ -231,9 +247,13 @@ namespace sqlpp
     bool bind_result_t::next_impl()
     {
       if (_handle->debug)
-        std::cerr << "Sqlite3 debug: Accessing next row of handle at " << _handle.get() << std::endl;
+        detail::log_debug(*_handle, -1, "Accessing next row");
 
-      auto rc = sqlite3_step(_handle->sqlite_statement);
+      auto rc = SQLITE_OK;
+      {
+        detail::phase_timer timer(_handle->latency.get(), &statement_latency::step);
+        rc = sqlite3_step(_handle->sqlite_statement);
+      }
 
       switch (rc)
       {
@@ -0,0 +1,176 @@
+/*
+ * Copyright (c) 2013 - 2016, Roland Bock
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ *   Redistributions of source code must retain the above copyright notice, this
+ *   list of conditions and the following disclaimer.
+ *
+ *   Redistributions in binary form must reproduce the above copyright notice, this
+ *   list of conditions and the following disclaimer in the documentation and/or
+ *   other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON
+ * ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifdef SQLPP_USE_SQLCIPHER
+#include <sqlcipher/sqlite3.h>
+#else
+#include <sqlite3.h>
+#endif
+#include <limits>
+#include <sqlpp11/exception.h>
+#include <sqlpp11/sqlite3/blob_stream.h>
+#include <sqlpp11/sqlite3/logger.h>
+#include <string>
+
+#ifdef SQLPP_DYNAMIC_LOADING
+#include <sqlpp11/sqlite3/dynamic_libsqlite3.h>
+#endif
+
+namespace sqlpp
+{
+  namespace sqlite3
+  {
+#ifdef SQLPP_DYNAMIC_LOADING
+    using namespace dynamic;
+#endif
+
+    namespace
+    {
+      int checked_int(size_t value, const char* what)
+      {
+        if (value > static_cast<size_t>(std::numeric_limits<int>::max()))
+          throw sqlpp::exception(std::string("Sqlite3 error: blob ") + what + " out of range");
+        return static_cast<int>(value);
+      }
+    }  // namespace
+
+    blob_stream::blob_stream(::sqlite3* db, sqlite3_blob* blob, std::shared_ptr<logger> log)
+        : _db(db), _blob(blob), _position(0), _log(std::move(log))
+    {
+    }
+
+    blob_stream::blob_stream(blob_stream&& rhs) noexcept
+        : _db(rhs._db), _blob(rhs._blob), _position(rhs._position), _log(std::move(rhs._log))
+    {
+      rhs._blob = nullptr;
+      rhs._position = 0;
+    }
+
+    blob_stream& blob_stream::operator=(blob_stream&& rhs) noexcept
+    {
+      if (this != &rhs)
+      {
+        if (_blob)
+          sqlite3_blob_close(_blob);
+        _db = rhs._db;
+        _blob = rhs._blob;
+        _position = rhs._position;
+        _log = std::move(rhs._log);
+        rhs._blob = nullptr;
+        rhs._position = 0;
+      }
+      return *this;
+    }
+
+    blob_stream::~blob_stream()
+    {
+      if (_blob and sqlite3_blob_close(_blob) != SQLITE_OK)
+      {
+        try
+        {
+          _log->log(log_record(log_level::error, "Can't close blob: " + std::string(sqlite3_errmsg(_db))));
+        }
+        catch (...)
+        {
+        }
+      }
+    }
+
+    size_t blob_stream::size() const
+    {
+      if (not _blob)
+        throw sqlpp::exception("Sqlite3 error: blob stream is not open");
+      return static_cast<size_t>(sqlite3_blob_bytes(_blob));
+    }
+
+    size_t blob_stream::read(uint8_t* buffer, size_t size, size_t offset) const
+    {
+      const auto total = this->size();
+      if (offset >= total)
+        return 0;
+      if (size > total - offset)
+        size = total - offset;
+      const auto rc = sqlite3_blob_read(_blob, buffer, checked_int(size, "read size"), checked_int(offset, "offset"));
+      if (rc != SQLITE_OK)
+      {
+        throw sqlpp::exception("Sqlite3 error: Could not read blob: " + std::string(sqlite3_errmsg(_db)));
+      }
+      return size;
+    }
+
+    void blob_stream::write(const uint8_t* data, size_t size, size_t offset)
+    {
+      if (not _blob)
+        throw sqlpp::exception("Sqlite3 error: blob stream is not open");
+      const auto rc =
+          sqlite3_blob_write(_blob, data, checked_int(size, "write size"), checked_int(offset, "offset"));
+      if (rc != SQLITE_OK)
+      {
+        throw sqlpp::exception("Sqlite3 error: Could not write blob: " + std::string(sqlite3_errmsg(_db)));
+      }
+    }
+
+    size_t blob_stream::read(uint8_t* buffer, size_t size)
+    {
+      const auto count = read(buffer, size, _position);
+      _position += count;
+      return count;
+    }
+
+    void blob_stream::write(const uint8_t* data, size_t size)
+    {
+      write(data, size, _position);
+      _position += size;
+    }
+
+    void blob_stream::reopen(int64_t rowid)
+    {
+      if (not _blob)
+        throw sqlpp::exception("Sqlite3 error: blob stream is not open");
+      const auto rc = sqlite3_blob_reopen(_blob, rowid);
+      _position = 0;
+      if (rc != SQLITE_OK)
+      {
+        // the stream is aborted and can only be closed
+        throw sqlpp::exception("Sqlite3 error: Could not reopen blob at row " + std::to_string(rowid) + ": " +
+                               std::string(sqlite3_errmsg(_db)));
+      }
+    }
+
+    void blob_stream::close()
+    {
+      if (not _blob)
+        return;
+      const auto rc = sqlite3_blob_close(_blob);
+      _blob = nullptr;
+      _position = 0;
+      if (rc != SQLITE_OK)
+      {
+        throw sqlpp::exception("Sqlite3 error: Could not close blob: " + std::string(sqlite3_errmsg(_db)));
+      }
+    }
+  }  // namespace sqlite3
+}  // namespace sqlpp
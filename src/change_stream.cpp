@@ -0,0 +1,386 @@
+/*
+ * Copyright (c) 2015 - 2016, Roland Bock
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ *  * Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ * LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE
+ * OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ * OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifdef SQLPP_USE_SQLCIPHER
+#include <sqlcipher/sqlite3.h>
+#else
+#include <sqlite3.h>
+#endif
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <iterator>
+#include <mutex>
+#include <sqlpp11/exception.h>
+#include <sqlpp11/sqlite3/change_stream.h>
+#include <sqlpp11/sqlite3/connection.h>
+#include <sqlpp11/sqlite3/logger.h>
+#include <thread>
+#include "detail/connection_handle.h"
+#include "detail/log.h"
+
+#ifdef SQLPP_DYNAMIC_LOADING
+#include <sqlpp11/sqlite3/dynamic_libsqlite3.h>
+#endif
+
+namespace sqlpp
+{
+  namespace sqlite3
+  {
+#ifdef SQLPP_DYNAMIC_LOADING
+    using namespace dynamic;
+#endif
+
+    // Single producer (the hooks and the connection, running in the thread using the connection), single consumer
+    // (the publisher thread) ring buffer. The mutex is only taken to sleep and wake up, i.e. if the queue is empty or
+    // full.
+    struct change_stream::state : detail::transaction_observer
+    {
+      connection& db_connection;
+      ::sqlite3* const db;
+      const std::shared_ptr<logger> log;  // the connection's
+      const publisher publish;
+      std::vector<row_change> slots;
+      // producer only
+      std::vector<row_change> pending;     // changes of the open transaction
+      std::vector<size_t> savepoints;      // size of pending when the savepoint at depth i + 1 has been created
+      std::vector<row_change> committing;  // changes of transactions whose commit has started, but may still fail
+
+      std::atomic<size_t> head{0};  // next slot to publish, advanced by the consumer
+      std::atomic<size_t> tail{0};  // next slot to fill, advanced by the producer
+      std::atomic<bool> consumer_waiting{false};
+      std::atomic<size_t> published{0};
+
+      std::mutex mutex;
+      std::condition_variable filled;
+      std::condition_variable drained;
+      bool stopping = false;
+      std::thread thread;
+
+      state(connection& connection_, publisher publish_, size_t capacity)
+          : db_connection(connection_),
+            db(connection_.native_handle()),
+            log(connection_.get_logger()),
+            publish(std::move(publish_)),
+            slots(capacity ? capacity : 1)
+      {
+      }
+
+      // must neither stop the publisher thread nor propagate into sqlite3
+      template <typename... Args>
+      void warn(const Args&... args) noexcept
+      {
+        try
+        {
+          detail::log(*log, log_level::warning, nullptr, -1, args...);
+        }
+        catch (...)
+        {
+        }
+      }
+
+      void wake_consumer()
+      {
+        if (consumer_waiting.load())
+        {
+          std::lock_guard<std::mutex> lock(mutex);
+          filled.notify_one();
+        }
+      }
+
+      void push(row_change&& change)
+      {
+        const auto t = tail.load(std::memory_order_relaxed);
+        if (t - head.load(std::memory_order_acquire) == slots.size())
+        {
+          wake_consumer();
+          std::unique_lock<std::mutex> lock(mutex);
+          drained.wait(lock, [this, t] { return t - head.load() < slots.size(); });
+        }
+        slots[t % slots.size()] = std::move(change);
+        tail.store(t + 1);
+      }
+
+      // sqlite3 is about to commit, which may still fail (e.g. with SQLITE_BUSY)
+      void commit_started()
+      {
+        std::move(pending.begin(), pending.end(), std::back_inserter(committing));
+        pending.clear();
+        savepoints.clear();
+      }
+
+      void rolled_back()
+      {
+        pending.clear();
+        savepoints.clear();
+        committing.clear();
+      }
+
+      void savepoint_started(size_t depth) override
+      {
+        savepoints.resize(depth - 1);
+        savepoints.push_back(pending.size());
+      }
+
+      void rolled_back_to_savepoint(size_t depth) override
+      {
+        if (depth <= savepoints.size() and savepoints[depth - 1] < pending.size())
+          pending.erase(pending.begin() + static_cast<std::ptrdiff_t>(savepoints[depth - 1]), pending.end());
+      }
+
+      void committed() override
+      {
+        if (committing.empty())
+          return;
+        for (auto& change : committing)
+          push(std::move(change));
+        committing.clear();
+        wake_consumer();
+      }
+
+      void flush()
+      {
+        const auto target = tail.load();
+        wake_consumer();
+        std::unique_lock<std::mutex> lock(mutex);
+        drained.wait(lock, [this, target] { return head.load() >= target; });
+      }
+
+      void run()
+      {
+        while (true)
+        {
+          auto h = head.load(std::memory_order_relaxed);
+          const auto t = tail.load(std::memory_order_acquire);
+          if (h == t)
+          {
+            std::unique_lock<std::mutex> lock(mutex);
+            consumer_waiting = true;
+            filled.wait(lock, [this, h] { return stopping or tail.load() != h; });
+            consumer_waiting = false;
+            if (tail.load() == h)
+              return;  // stopping and nothing left to publish
+            continue;
+          }
+
+          for (; h != t; ++h)
+          {
+            auto& slot = slots[h % slots.size()];
+            try
+            {
+              publish(slot);
+            }
+            catch (const std::exception& e)
+            {
+              warn("Publishing a change of ", slot.table, " failed: ", e.what());
+            }
+            catch (...)
+            {
+              warn("Publishing a change of ", slot.table, " failed: unknown exception");
+            }
+            slot = row_change{};
+            head.store(h + 1, std::memory_order_release);
+            ++published;
+          }
+          {
+            std::lock_guard<std::mutex> lock(mutex);
+          }
+          drained.notify_all();
+        }
+      }
+    };
+
+    namespace
+    {
+      // with dynamic loading, optional functions are nullptr if the library does not provide them
+      template <typename Function>
+      bool is_loaded(Function* function)
+      {
+        return function != nullptr;
+      }
+
+      void check_preupdate_hook_support()
+      {
+#ifdef SQLITE_ENABLE_PREUPDATE_HOOK
+        if (runtime_features().preupdate_hook and is_loaded(sqlite3_preupdate_hook))
+        {
+          return;
+        }
+#endif
+        throw sqlpp::exception("Sqlite3 error: preupdate hook not supported by sqlite3 " +
+                               std::to_string(runtime_features().version_number) +
+                               " (requires SQLITE_ENABLE_PREUPDATE_HOOK)");
+      }
+
+#ifdef SQLITE_ENABLE_PREUPDATE_HOOK
+      column_value decode(sqlite3_value* value)
+      {
+        column_value result;
+        switch (sqlite3_value_type(value))
+        {
+          case SQLITE_INTEGER:
+            result.type = value_type::integer;
+            result.integer = sqlite3_value_int64(value);
+            break;
+          case SQLITE_FLOAT:
+            result.type = value_type::floating_point;
+            result.floating_point = sqlite3_value_double(value);
+            break;
+          case SQLITE_TEXT:
+            result.type = value_type::text;
+            result.bytes.assign(reinterpret_cast<const char*>(sqlite3_value_text(value)),
+                                static_cast<size_t>(sqlite3_value_bytes(value)));
+            break;
+          case SQLITE_BLOB:
+          {
+            result.type = value_type::blob;
+            // sqlite3_value_blob returns nullptr for empty blobs
+            const auto data = static_cast<const char*>(sqlite3_value_blob(value));
+            if (data)
+              result.bytes.assign(data, static_cast<size_t>(sqlite3_value_bytes(value)));
+            break;
+          }
+          default:
+            break;
+        }
+        return result;
+      }
+
+      void read_values(::sqlite3* db, int (*read)(::sqlite3*, int, sqlite3_value**), std::vector<column_value>& values)
+      {
+        const auto count = sqlite3_preupdate_count(db);
+        values.reserve(static_cast<size_t>(count));
+        for (int i = 0; i < count; ++i)
+        {
+          sqlite3_value* value = nullptr;
+          if (read(db, i, &value) == SQLITE_OK and value)
+            values.push_back(decode(value));
+          else
+            values.push_back(column_value{});
+        }
+      }
+
+      void preupdate_hook(void* arg,
+                          ::sqlite3* db,
+                          int operation,
+                          const char* schema,
+                          const char* table,
+                          sqlite3_int64 old_rowid,
+                          sqlite3_int64 new_rowid)
+      {
+        auto s = static_cast<change_stream::state*>(arg);
+        try
+        {
+          row_change change;
+          change.schema = schema;
+          change.table = table;
+          switch (operation)
+          {
+            case SQLITE_INSERT:
+              change.operation = change_operation::insert;
+              change.new_rowid = new_rowid;
+              read_values(db, sqlite3_preupdate_new, change.new_values);
+              break;
+            case SQLITE_UPDATE:
+              change.operation = change_operation::update;
+              change.old_rowid = old_rowid;
+              change.new_rowid = new_rowid;
+              read_values(db, sqlite3_preupdate_old, change.old_values);
+              read_values(db, sqlite3_preupdate_new, change.new_values);
+              break;
+            default:
+              change.operation = change_operation::remove;
+              change.old_rowid = old_rowid;
+              read_values(db, sqlite3_preupdate_old, change.old_values);
+              break;
+          }
+          s->pending.push_back(std::move(change));
+        }
+        catch (const std::exception& e)
+        {
+          s->warn("Could not record a change of ", table, ": ", e.what());
+        }
+        catch (...)
+        {
+          s->warn("Could not record a change of ", table, ": unknown exception");
+        }
+      }
+#endif
+
+      int commit_hook(void* arg)
+      {
+        static_cast<change_stream::state*>(arg)->commit_started();
+        return 0;
+      }
+
+      void rollback_hook(void* arg)
+      {
+        static_cast<change_stream::state*>(arg)->rolled_back();
+      }
+    }  // namespace
+
+    change_stream::change_stream(connection& db, publisher publish, size_t capacity)
+    {
+      check_preupdate_hook_support();
+      _state.reset(new state(db, std::move(publish), capacity));
+      _state->thread = std::thread([this] { _state->run(); });
+#ifdef SQLITE_ENABLE_PREUPDATE_HOOK
+      sqlite3_preupdate_hook(_state->db, &preupdate_hook, _state.get());
+#endif
+      sqlite3_commit_hook(_state->db, &commit_hook, _state.get());
+      sqlite3_rollback_hook(_state->db, &rollback_hook, _state.get());
+      _state->db_connection._set_transaction_observer(_state.get());
+    }
+
+    change_stream::~change_stream()
+    {
+      _state->db_connection._set_transaction_observer(nullptr);
+      // e.g. the commit of a statement stepped by a bind_result
+      if (sqlite3_get_autocommit(_state->db))
+        _state->committed();
+#ifdef SQLITE_ENABLE_PREUPDATE_HOOK
+      sqlite3_preupdate_hook(_state->db, nullptr, nullptr);
+#endif
+      sqlite3_commit_hook(_state->db, nullptr, nullptr);
+      sqlite3_rollback_hook(_state->db, nullptr, nullptr);
+      {
+        std::lock_guard<std::mutex> lock(_state->mutex);
+        _state->stopping = true;
+      }
+      _state->filled.notify_one();
+      _state->thread.join();
+    }
+
+    void change_stream::flush()
+    {
+      _state->flush();
+    }
+
+    size_t change_stream::published() const
+    {
+      return _state->published.load();
+    }
+  }  // namespace sqlite3
+}  // namespace sqlpp
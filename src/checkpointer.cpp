@@ -0,0 +1,205 @@
+/*
+ * Copyright (c) 2015 - 2016, Roland Bock
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ *  * Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ * LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE
+ * OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ * OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <atomic>
+#include <condition_variable>
+#include <map>
+#include <mutex>
+#include <sqlpp11/exception.h>
+#include <sqlpp11/sqlite3/checkpointer.h>
+#include <thread>
+
+#ifdef SQLPP_DYNAMIC_LOADING
+#include <sqlpp11/sqlite3/dynamic_libsqlite3.h>
+#endif
+
+namespace sqlpp
+{
+  namespace sqlite3
+  {
+#ifdef SQLPP_DYNAMIC_LOADING
+    using namespace dynamic;
+#endif
+
+    struct background_checkpointer::state
+    {
+      const std::shared_ptr<logger> log;
+      connection db;
+      const checkpoint_mode mode;
+      const int frame_threshold;
+
+      mutable std::mutex mutex;
+      std::condition_variable condition;
+      std::atomic<bool> pending{false};
+      bool stopping = false;
+      size_t count = 0;
+      checkpoint_result result{-1, -1, false};
+      std::thread thread;
+      // autocheckpoint thresholds of the watched connections before watch(), restored by unwatch()
+      std::map<::sqlite3*, int> autocheckpoints;
+
+      state(connection_config config, checkpoint_mode mode_, int frame_threshold_)
+          : log(config.log ? config.log : default_logger()),
+            db(std::move(config)),
+            mode(mode_),
+            frame_threshold(frame_threshold_)
+      {
+        // the connection only notices WAL mode once it has read from the database
+        db.execute("PRAGMA schema_version");
+      }
+
+      void notify()
+      {
+        // called by committing connections: avoid taking the lock if a checkpoint is pending already
+        if (not pending.exchange(true))
+        {
+          std::lock_guard<std::mutex> lock(mutex);
+          condition.notify_one();
+        }
+      }
+
+      void run()
+      {
+        std::unique_lock<std::mutex> lock(mutex);
+        while (true)
+        {
+          condition.wait(lock, [this] { return stopping or pending.load(); });
+          if (stopping)
+          {
+            return;
+          }
+          pending = false;
+
+          lock.unlock();
+          checkpoint_result current{-1, -1, false};
+          try
+          {
+            current = db.checkpoint(mode);
+          }
+          catch (const sqlpp::exception& e)
+          {
+            log->log(log_record(log_level::warning, "Background checkpoint failed: " + std::string(e.what())));
+          }
+          lock.lock();
+
+          result = current;
+          ++count;
+        }
+      }
+    };
+
+    namespace
+    {
+      int read_autocheckpoint(::sqlite3* db)
+      {
+        sqlite3_stmt* statement = nullptr;
+        if (sqlite3_prepare_v2(db, "PRAGMA wal_autocheckpoint", -1, &statement, nullptr) != SQLITE_OK)
+          throw sqlpp::exception("Sqlite3 error: Could not read wal_autocheckpoint: " +
+                                 std::string(sqlite3_errmsg(db)));
+        const auto rc = sqlite3_step(statement);
+        const auto frames = rc == SQLITE_ROW ? sqlite3_column_int(statement, 0) : 0;
+        sqlite3_finalize(statement);
+        if (rc != SQLITE_ROW)
+          throw sqlpp::exception("Sqlite3 error: Could not read wal_autocheckpoint: " +
+                                 std::string(sqlite3_errmsg(db)));
+        return frames;
+      }
+
+      int wal_hook(void* arg, ::sqlite3*, const char*, int frames)
+      {
+        auto s = static_cast<background_checkpointer::state*>(arg);
+        if (frames >= s->frame_threshold)
+        {
+          s->notify();
+        }
+        return SQLITE_OK;
+      }
+    }  // namespace
+
+    background_checkpointer::background_checkpointer(connection_config config,
+                                                     checkpoint_mode mode,
+                                                     int frame_threshold)
+        : _state(new state(std::move(config), mode, frame_threshold))
+    {
+      _state->thread = std::thread([this] { _state->run(); });
+    }
+
+    background_checkpointer::~background_checkpointer()
+    {
+      {
+        std::lock_guard<std::mutex> lock(_state->mutex);
+        _state->stopping = true;
+      }
+      _state->condition.notify_one();
+      _state->thread.join();
+    }
+
+    void background_checkpointer::watch(connection& db)
+    {
+      {
+        std::lock_guard<std::mutex> lock(_state->mutex);
+        // once watched, the pragma reports 0, so keep the threshold of the first call
+        if (_state->autocheckpoints.find(db.native_handle()) == _state->autocheckpoints.end())
+          _state->autocheckpoints[db.native_handle()] = read_autocheckpoint(db.native_handle());
+      }
+      // replaces the autocheckpoint hook, too
+      sqlite3_wal_hook(db.native_handle(), &wal_hook, _state.get());
+    }
+
+    void background_checkpointer::unwatch(connection& db)
+    {
+      // 1000 frames is sqlite3's default autocheckpoint threshold, for connections that were never watched
+      int frames = 1000;
+      {
+        std::lock_guard<std::mutex> lock(_state->mutex);
+        const auto it = _state->autocheckpoints.find(db.native_handle());
+        if (it != _state->autocheckpoints.end())
+        {
+          frames = it->second;
+          _state->autocheckpoints.erase(it);
+        }
+      }
+      // a threshold <= 0 disables autocheckpoints again
+      sqlite3_wal_autocheckpoint(db.native_handle(), frames);
+    }
+
+    void background_checkpointer::request()
+    {
+      _state->notify();
+    }
+
+    size_t background_checkpointer::checkpoint_count() const
+    {
+      std::lock_guard<std::mutex> lock(_state->mutex);
+      return _state->count;
+    }
+
+    checkpoint_result background_checkpointer::last_result() const
+    {
+      std::lock_guard<std::mutex> lock(_state->mutex);
+      return _state->result;
+    }
+  }  // namespace sqlite3
+}  // namespace sqlpp
@@ -25,8 +25,10 @@
  */
 
 #include "detail/connection_handle.h"
+#include "detail/latency_timer.h"
+#include "detail/log.h"
 #include "detail/prepared_statement_handle.h"
-#include <iostream>
+#include <algorithm>
 #include <sqlpp11/exception.h>
 #include <sqlpp11/sqlite3/connection.h>
 
@@ -45,16 +47,69 @@ namespace sqlpp
 
     namespace
     {
+      bool is_read_only_statement(sqlite3_stmt* statement)
+      {
+#if SQLITE_VERSION_NUMBER >= 3008007
+#ifdef SQLPP_DYNAMIC_LOADING
+        if (!sqlite3_stmt_readonly)
+          return false;  // unknown, assume it writes
+#endif
+        return sqlite3_stmt_readonly(statement) != 0;
+#else
+        (void)statement;
+        return false;
+#endif
+      }
+
+      // statements with literal values (anything not explicitly prepared) get an entry each, so the number of
+      // distinct entries is bounded; the rest is accounted to a common one
+      constexpr size_t max_latency_entries = 1000;
+
+      std::shared_ptr<statement_latency> latency_of(detail::connection_handle& handle, const std::string& statement)
+      {
+        auto it = handle.latency.find(statement);
+        if (it == handle.latency.end())
+        {
+          const auto key = handle.latency.size() < max_latency_entries ? statement : std::string("(other statements)");
+          it = handle.latency.emplace(key, nullptr).first;
+          if (!it->second)
+            it->second = std::make_shared<statement_latency>();
+        }
+        return it->second;
+      }
+
+      // persistent: the statement is kept for a while (explicitly prepared or cached), so sqlite3 should not use
+      // lookaside memory for it
       detail::prepared_statement_handle_t prepare_statement(detail::connection_handle& handle,
-                                                            const std::string& statement)
+                                                            const std::string& statement,
+                                                            bool persistent = false)
       {
         if (handle.config.debug)
-          std::cerr << "Sqlite3 debug: Preparing: '" << statement << "'" << std::endl;
+          detail::log(*handle.config.log, log_level::debug, nullptr, -1, "Preparing", (persistent ? " persistent" : ""),
+                      ": '", statement, "'");
 
-        detail::prepared_statement_handle_t result(nullptr, handle.config.debug);
+        detail::prepared_statement_handle_t result(nullptr, handle.config.debug, handle.config.log.get());
+        if (handle.config.latency_histograms)
+          result.latency = latency_of(handle, statement);
+        detail::phase_timer timer(result.latency.get(), &statement_latency::prepare);
 
+#if SQLITE_VERSION_NUMBER >= 3020000
+        auto rc = SQLITE_OK;
+        if (runtime_features().prepare_v3)
+        {
+          const auto flags = handle.config.prepare_flags | (persistent ? SQLITE_PREPARE_PERSISTENT : 0u);
+          rc = sqlite3_prepare_v3(handle.sqlite, statement.c_str(), static_cast<int>(statement.size()), flags,
+                                  &result.sqlite_statement, nullptr);
+        }
+        else
+        {
+          rc = sqlite3_prepare_v2(handle.sqlite, statement.c_str(), static_cast<int>(statement.size()),
+                                  &result.sqlite_statement, nullptr);
+        }
+#else
         auto rc = sqlite3_prepare_v2(handle.sqlite, statement.c_str(), static_cast<int>(statement.size()),
                                      &result.sqlite_statement, nullptr);
+#endif
 
         if (rc != SQLITE_OK)
         {
@@ -63,26 +118,197 @@ namespace sqlpp
                                  (rc == SQLITE_TOOBIG ? statement.substr(0, 128) + "..." : statement) +
                                  "<<\n");
         }
+        result.read_only = is_read_only_statement(result.sqlite_statement);
 
         return result;
       }
 
+      void read_db_status(::sqlite3* db, int op, int64_t& current, int64_t& highwater)
+      {
+        int cur = 0;
+        int high = 0;
+        if (sqlite3_db_status(db, op, &cur, &high, 0) != SQLITE_OK)
+          throw sqlpp::exception("Sqlite3 error: Could not read connection status " + std::to_string(op) + ": " +
+                                 std::string(sqlite3_errmsg(db)));
+        current = cur;
+        highwater = high;
+      }
+
+      void read_db_status(::sqlite3* db, status_gauge& gauge, const status_gauge& previous, int op)
+      {
+        read_db_status(db, op, gauge.current, gauge.highwater);
+        gauge.delta = gauge.current - previous.current;
+      }
+
+      // use_highwater: some counters (e.g. lookaside hits) are reported in the highwater slot
+      void read_db_status(
+          ::sqlite3* db, status_counter& counter, const status_counter& previous, int op, bool use_highwater = false)
+      {
+        int64_t current = 0;
+        int64_t highwater = 0;
+        read_db_status(db, op, current, highwater);
+        counter.total = use_highwater ? highwater : current;
+        counter.delta = counter.total - previous.total;
+      }
+
+      void notify_if_committed(detail::connection_handle& handle)
+      {
+        if (handle.observer and sqlite3_get_autocommit(handle.sqlite))
+          handle.observer->committed();
+      }
+
       void execute_statement(detail::connection_handle& handle, detail::prepared_statement_handle_t& prepared)
       {
-        auto rc = sqlite3_step(prepared.sqlite_statement);
+        // a commit made without the connection (e.g. using native_handle()) must not wait for this statement
+        notify_if_committed(handle);
+        // only measured if it is logged
+        using clock = std::chrono::steady_clock;
+        const auto start = handle.config.debug ? clock::now() : clock::time_point{};
+        auto rc = SQLITE_OK;
+        {
+          detail::phase_timer timer(prepared.latency.get(), &statement_latency::step);
+          rc = sqlite3_step(prepared.sqlite_statement);
+        }
+        if (handle.config.debug)
+        {
+          log_record record(log_level::debug, "sqlite3_step return code: " + std::to_string(rc), &prepared);
+          record.duration = std::chrono::duration_cast<std::chrono::microseconds>(clock::now() - start);
+          handle.config.log->log(record);
+        }
         switch (rc)
         {
           case SQLITE_OK:
           case SQLITE_ROW:  // might occur if execute is called with a select
           case SQLITE_DONE:
+            notify_if_committed(handle);
             return;
           default:
-            if(handle.config.debug)
-              std::cerr << "Sqlite3 debug: sqlite3_step return code: " << rc << std::endl;
             throw sqlpp::exception("Sqlite3 error: Could not execute statement: " +
                                    std::string(sqlite3_errmsg(handle.sqlite)));
         }
       }
+
+      // run a statement without parameters, keeping it prepared for the next call
+      void execute_cached_statement(detail::connection_handle& handle, const std::string& statement)
+      {
+        auto it = handle.statement_cache.find(statement);
+        if (it == handle.statement_cache.end())
+        {
+          it = handle.statement_cache.emplace(statement, prepare_statement(handle, statement, true)).first;
+        }
+        else if (handle.config.debug)
+        {
+          detail::log(*handle.config.log, log_level::debug, &it->second, -1, "Executing cached: '", statement, "'");
+        }
+        auto& prepared = it->second;
+        try
+        {
+          execute_statement(handle, prepared);
+        }
+        catch (...)
+        {
+          sqlite3_reset(prepared.sqlite_statement);
+          throw;
+        }
+        detail::phase_timer timer(prepared.latency.get(), &statement_latency::reset);
+        sqlite3_reset(prepared.sqlite_statement);
+      }
+
+      const char* begin_statement(transaction_mode mode)
+      {
+        switch (mode)
+        {
+          case transaction_mode::immediate:
+            return "BEGIN IMMEDIATE";
+          case transaction_mode::exclusive:
+            return "BEGIN EXCLUSIVE";
+          case transaction_mode::deferred:
+          default:
+            return "BEGIN";
+        }
+      }
+
+      transaction_mode transaction_mode_of(isolation_level level, transaction_mode default_mode)
+      {
+        switch (level)
+        {
+          case isolation_level::serializable:
+            return transaction_mode::exclusive;
+          case isolation_level::repeatable_read:
+            return transaction_mode::immediate;
+          case isolation_level::read_committed:
+          case isolation_level::read_uncommitted:
+            return transaction_mode::deferred;
+          case isolation_level::undefined:
+          default:
+            return default_mode;
+        }
+      }
+
+#if SQLITE_VERSION_NUMBER >= 3036000
+      void check_serialize_support()
+      {
+        if (not runtime_features().serialize)
+        {
+          throw sqlpp::exception("Sqlite3 error: serialize/deserialize not supported by sqlite3 " +
+                                 std::to_string(runtime_features().version_number));
+        }
+      }
+#endif
+
+      std::string savepoint_statement(const std::string& command, size_t depth)
+      {
+        return command + " sqlpp_savepoint_" + std::to_string(depth);
+      }
+
+      void run_backup(::sqlite3* source,
+                      const std::string& schema,
+                      ::sqlite3* target,
+                      int pages_per_step,
+                      std::chrono::milliseconds sleep_between_steps,
+                      const backup_progress_t& progress)
+      {
+        auto backup = sqlite3_backup_init(target, "main", source, schema.c_str());
+        if (!backup)
+        {
+          throw sqlpp::exception("Sqlite3 error: Could not start backup: " + std::string(sqlite3_errmsg(target)));
+        }
+
+        int rc = SQLITE_OK;
+        try
+        {
+          do
+          {
+            rc = sqlite3_backup_step(backup, pages_per_step);
+            if (progress)
+            {
+              progress(sqlite3_backup_remaining(backup), sqlite3_backup_pagecount(backup));
+            }
+            if (rc == SQLITE_BUSY or rc == SQLITE_LOCKED)
+            {
+              // somebody else holds the lock, never spin while waiting for it
+              sqlite3_sleep(std::max(1, static_cast<int>(sleep_between_steps.count())));
+            }
+            else if (rc == SQLITE_OK and sleep_between_steps.count() > 0)
+            {
+              // the source is unlocked between steps, giving writers a chance to proceed
+              sqlite3_sleep(static_cast<int>(sleep_between_steps.count()));
+            }
+          } while (rc == SQLITE_OK or rc == SQLITE_BUSY or rc == SQLITE_LOCKED);
+        }
+        catch (...)
+        {
+          sqlite3_backup_finish(backup);
+          throw;
+        }
+
+        // finishing the backup puts the error of the failed step into the target's error message
+        sqlite3_backup_finish(backup);
+        if (rc != SQLITE_DONE)
+        {
+          throw sqlpp::exception("Sqlite3 error: Could not complete backup: " + std::string(sqlite3_errmsg(target)));
+        }
+      }
     }
 
     connection::connection(connection_config config) : _handle(new detail::connection_handle(std::move(config)))
@@ -96,11 +322,73 @@ namespace sqlpp
     {
     }
 
+    const library_features& connection::features() const
+    {
+      return runtime_features();
+    }
+
     ::sqlite3* connection::native_handle()
     {
       return _handle->sqlite;
     }
 
+    void connection::register_function_impl(const std::string& name,
+                                            int arity,
+                                            int flags,
+                                            void* function_data,
+                                            void (*call)(sqlite3_context*, int, sqlite3_value**),
+                                            void (*step)(sqlite3_context*, int, sqlite3_value**),
+                                            void (*final)(sqlite3_context*),
+                                            void (*destroy)(void*))
+    {
+      auto rc = sqlite3_create_function_v2(_handle->sqlite, name.c_str(), arity, SQLITE_UTF8 | flags, function_data,
+                                           call, step, final, destroy);
+      if (rc != SQLITE_OK)
+      {
+        throw sqlpp::exception("Sqlite3 error: Could not register function " + name + ": " +
+                               std::string(sqlite3_errmsg(_handle->sqlite)));
+      }
+    }
+
+    void connection::create_module_impl(const std::string& name,
+                                        const sqlite3_module* module,
+                                        void* client_data,
+                                        void (*destroy)(void*))
+    {
+      // destroy is called by sqlite3 on failure as well
+      auto rc = sqlite3_create_module_v2(_handle->sqlite, name.c_str(), module, client_data, destroy);
+      if (rc != SQLITE_OK)
+      {
+        throw sqlpp::exception("Sqlite3 error: Could not create module " + name + ": " +
+                               std::string(sqlite3_errmsg(_handle->sqlite)));
+      }
+    }
+
+#if SQLITE_VERSION_NUMBER >= 3025000
+    void connection::register_window_function_impl(const std::string& name,
+                                                   int arity,
+                                                   int flags,
+                                                   void (*step)(sqlite3_context*, int, sqlite3_value**),
+                                                   void (*final)(sqlite3_context*),
+                                                   void (*value)(sqlite3_context*),
+                                                   void (*inverse)(sqlite3_context*, int, sqlite3_value**))
+    {
+      if (not runtime_features().window_functions)
+      {
+        throw sqlpp::exception("Sqlite3 error: Could not register window function " + name +
+                               ": not supported by sqlite3 " +
+                               std::to_string(runtime_features().version_number));
+      }
+      auto rc = sqlite3_create_window_function(_handle->sqlite, name.c_str(), arity, SQLITE_UTF8 | flags, nullptr,
+                                               step, final, value, inverse, nullptr);
+      if (rc != SQLITE_OK)
+      {
+        throw sqlpp::exception("Sqlite3 error: Could not register window function " + name + ": " +
+                               std::string(sqlite3_errmsg(_handle->sqlite)));
+      }
+    }
+#endif
+
     bind_result_t connection::select_impl(const std::string& statement)
     {
       std::unique_ptr<detail::prepared_statement_handle_t> prepared(
@@ -129,7 +417,7 @@ namespace sqlpp
     prepared_statement_t connection::prepare_impl(const std::string& statement)
     {
       return {std::unique_ptr<detail::prepared_statement_handle_t>(
-          new detail::prepared_statement_handle_t(prepare_statement(*_handle, statement)))};
+          new detail::prepared_statement_handle_t(prepare_statement(*_handle, statement, true)))};
     }
 
     size_t connection::run_prepared_insert_impl(prepared_statement_t& prepared_statement)
@@ -217,16 +505,54 @@ namespace sqlpp
                           sqlpp::isolation_level::read_uncommitted;
     }
 
+    void connection::set_default_transaction_mode(transaction_mode mode)
+    {
+      _handle->config.default_transaction_mode = mode;
+    }
+
+    transaction_mode connection::get_default_transaction_mode() const
+    {
+      return _handle->config.default_transaction_mode;
+    }
+
     void connection::start_transaction()
+    {
+      auto mode = _handle->config.default_transaction_mode;
+      if (_has_next_transaction_mode)
+      {
+        mode = _next_transaction_mode;
+        _has_next_transaction_mode = false;
+      }
+      start_transaction(mode);
+    }
+
+    void connection::start_transaction(isolation_level level)
+    {
+      start_transaction(transaction_mode_of(level, _handle->config.default_transaction_mode));
+    }
+
+    void connection::start_transaction(transaction_mode mode)
     {
       if (_transaction_status == transaction_status_type::active)
       {
-        throw sqlpp::exception("Sqlite3 error: Cannot have more than one open transaction per connection");
+        execute_cached_statement(*_handle, savepoint_statement("SAVEPOINT", _savepoint_depth + 1));
+        ++_savepoint_depth;
+        if (_handle->observer)
+          _handle->observer->savepoint_started(_savepoint_depth);
+        return;
       }
 
       _transaction_status = transaction_status_type::maybe;
-      auto prepared = prepare_statement(*_handle, "BEGIN");
-      execute_statement(*_handle, prepared);
+      try
+      {
+        execute_cached_statement(*_handle, begin_statement(mode));
+      }
+      catch (...)
+      {
+        // e.g. SQLITE_BUSY for BEGIN IMMEDIATE, nothing to roll back
+        _transaction_status = transaction_status_type::none;
+        throw;
+      }
       _transaction_status = transaction_status_type::active;
     }
 
@@ -236,9 +562,13 @@ namespace sqlpp
       {
         throw sqlpp::exception("Sqlite3 error: Cannot commit a finished or failed transaction");
       }
+      if (_savepoint_depth > 0)
+      {
+        end_savepoint(false);
+        return;
+      }
       _transaction_status = transaction_status_type::maybe;
-      auto prepared = prepare_statement(*_handle, "COMMIT");
-      execute_statement(*_handle, prepared);
+      execute_cached_statement(*_handle, "COMMIT");
       _transaction_status = transaction_status_type::none;
     }
 
@@ -250,17 +580,74 @@ namespace sqlpp
       }
       if (report)
       {
-        std::cerr << "Sqlite3 warning: Rolling back unfinished transaction" << std::endl;
+        detail::log(*_handle->config.log, log_level::warning, nullptr, -1, "Rolling back unfinished transaction");
+      }
+      if (_savepoint_depth > 0)
+      {
+        end_savepoint(true);
+        return;
       }
       _transaction_status = transaction_status_type::maybe;
-      auto prepared = prepare_statement(*_handle, "ROLLBACK");
-      execute_statement(*_handle, prepared);
+      execute_cached_statement(*_handle, "ROLLBACK");
       _transaction_status = transaction_status_type::none;
     }
 
+    void connection::end_savepoint(bool rollback)
+    {
+      // the savepoint is gone for the enclosing transaction, even if this fails
+      const auto depth = _savepoint_depth--;
+      try
+      {
+        // ROLLBACK TO keeps the savepoint on the stack
+        if (rollback)
+        {
+          execute_cached_statement(*_handle, savepoint_statement("ROLLBACK TO", depth));
+          if (_handle->observer)
+            _handle->observer->rolled_back_to_savepoint(depth);
+        }
+        execute_cached_statement(*_handle, savepoint_statement("RELEASE", depth));
+      }
+      catch (...)
+      {
+        // after e.g. SQLITE_FULL, SQLITE_IOERR or SQLITE_BUSY, sqlite3 may have rolled back the whole transaction
+        if (sqlite3_get_autocommit(_handle->sqlite))
+        {
+          _savepoint_depth = 0;
+          _transaction_status = transaction_status_type::none;
+        }
+        throw;
+      }
+    }
+
+    size_t connection::transaction_depth() const
+    {
+      return _transaction_status == transaction_status_type::none ? 0 : _savepoint_depth + 1;
+    }
+
+    const std::shared_ptr<logger>& connection::get_logger() const
+    {
+      return _handle->config.log;
+    }
+
+    void connection::_set_transaction_observer(detail::transaction_observer* observer)
+    {
+      _handle->observer = observer;
+    }
+
     void connection::report_rollback_failure(const std::string message) noexcept
     {
-      std::cerr << "Sqlite3 message:" << message << std::endl;
+      try
+      {
+        _handle->config.log->log(log_record(log_level::error, message));
+      }
+      catch (...)
+      {
+      }
+    }
+
+    bool connection::is_read_only(const std::string& statement)
+    {
+      return prepare_statement(*_handle, statement).read_only;
     }
 
     uint64_t connection::last_insert_id() noexcept
@@ -276,5 +663,146 @@ namespace sqlpp
 
       return {name};
     }
+
+    void connection::backup_to(connection& target,
+                               int pages_per_step,
+                               std::chrono::milliseconds sleep_between_steps,
+                               const backup_progress_t& progress,
+                               const std::string& schema)
+    {
+      run_backup(_handle->sqlite, schema, target._handle->sqlite, pages_per_step, sleep_between_steps, progress);
+    }
+
+    void connection::backup_to(const connection_config& target_config,
+                               int pages_per_step,
+                               std::chrono::milliseconds sleep_between_steps,
+                               const backup_progress_t& progress,
+                               const std::string& schema)
+    {
+      detail::connection_handle target(target_config);
+      run_backup(_handle->sqlite, schema, target.sqlite, pages_per_step, sleep_between_steps, progress);
+    }
+
+    checkpoint_result connection::checkpoint(checkpoint_mode mode, const std::string& schema)
+    {
+      checkpoint_result result{-1, -1, false};
+      auto rc = sqlite3_wal_checkpoint_v2(_handle->sqlite, schema.empty() ? nullptr : schema.c_str(),
+                                          static_cast<int>(mode), &result.log_frames, &result.checkpointed_frames);
+      switch (rc)
+      {
+        case SQLITE_OK:
+          return result;
+        case SQLITE_BUSY:
+          result.busy = true;
+          return result;
+        default:
+          throw sqlpp::exception("Sqlite3 error: Could not checkpoint: " + std::string(sqlite3_errmsg(_handle->sqlite)));
+      }
+    }
+
+    connection_stats connection::stats()
+    {
+      auto db = _handle->sqlite;
+      const auto& previous = _handle->last_stats;
+      connection_stats stats;
+      read_db_status(db, stats.cache_used, previous.cache_used, SQLITE_DBSTATUS_CACHE_USED);
+      read_db_status(db, stats.cache_hit, previous.cache_hit, SQLITE_DBSTATUS_CACHE_HIT);
+      read_db_status(db, stats.cache_miss, previous.cache_miss, SQLITE_DBSTATUS_CACHE_MISS);
+      read_db_status(db, stats.cache_write, previous.cache_write, SQLITE_DBSTATUS_CACHE_WRITE);
+#ifdef SQLITE_DBSTATUS_CACHE_SPILL
+      read_db_status(db, stats.cache_spill, previous.cache_spill, SQLITE_DBSTATUS_CACHE_SPILL);
+#endif
+      read_db_status(db, stats.lookaside_used, previous.lookaside_used, SQLITE_DBSTATUS_LOOKASIDE_USED);
+      read_db_status(db, stats.lookaside_hit, previous.lookaside_hit, SQLITE_DBSTATUS_LOOKASIDE_HIT, true);
+      read_db_status(db, stats.lookaside_miss_size, previous.lookaside_miss_size, SQLITE_DBSTATUS_LOOKASIDE_MISS_SIZE,
+                     true);
+      read_db_status(db, stats.lookaside_miss_full, previous.lookaside_miss_full, SQLITE_DBSTATUS_LOOKASIDE_MISS_FULL,
+                     true);
+      read_db_status(db, stats.schema_used, previous.schema_used, SQLITE_DBSTATUS_SCHEMA_USED);
+      read_db_status(db, stats.stmt_used, previous.stmt_used, SQLITE_DBSTATUS_STMT_USED);
+      _handle->last_stats = stats;
+      return stats;
+    }
+
+    latency_report connection::latency() const
+    {
+      latency_report report;
+      for (const auto& entry : _handle->latency)
+        report[entry.first].merge(*entry.second);
+      return report;
+    }
+
+    blob_stream connection::open_blob(const std::string& table,
+                                      const std::string& column,
+                                      int64_t rowid,
+                                      bool writable,
+                                      const std::string& schema)
+    {
+      sqlite3_blob* blob = nullptr;
+      auto rc = sqlite3_blob_open(_handle->sqlite, schema.c_str(), table.c_str(), column.c_str(), rowid,
+                                  writable ? 1 : 0, &blob);
+      if (rc != SQLITE_OK)
+      {
+        const std::string msg = sqlite3_errmsg(_handle->sqlite);
+        sqlite3_blob_close(blob);
+        throw sqlpp::exception("Sqlite3 error: Could not open blob " + table + "." + column + " at row " +
+                               std::to_string(rowid) + ": " + msg);
+      }
+      return {_handle->sqlite, blob, _handle->config.log};
+    }
+
+#if SQLITE_VERSION_NUMBER >= 3036000
+    serialized_database connection::serialize(const std::string& schema)
+    {
+      check_serialize_support();
+      sqlite3_int64 size = 0;
+      auto data = sqlite3_serialize(_handle->sqlite, schema.c_str(), &size, 0);
+      // an empty database has no pages and thus no image
+      if (!data and size != 0)
+      {
+        throw sqlpp::exception("Sqlite3 error: Could not serialize schema " + schema + ": " +
+                               std::string(sqlite3_errmsg(_handle->sqlite)));
+      }
+      return {data, static_cast<size_t>(size)};
+    }
+
+    void connection::deserialize(serialized_database image, const std::string& schema)
+    {
+      check_serialize_support();
+      const auto size = static_cast<sqlite3_int64>(image.size());
+      // with SQLITE_DESERIALIZE_FREEONCLOSE, sqlite3 owns the memory even if deserializing fails
+      auto rc = sqlite3_deserialize(_handle->sqlite, schema.c_str(), image.release(), size, size,
+                                    SQLITE_DESERIALIZE_FREEONCLOSE | SQLITE_DESERIALIZE_RESIZEABLE);
+      if (rc != SQLITE_OK)
+      {
+        throw sqlpp::exception("Sqlite3 error: Could not deserialize schema " + schema + ": " +
+                               std::string(sqlite3_errmsg(_handle->sqlite)));
+      }
+    }
+
+    void connection::deserialize(const std::vector<uint8_t>& data, const std::string& schema)
+    {
+      check_serialize_support();
+      auto copy = static_cast<uint8_t*>(sqlite3_malloc64(data.size()));
+      if (!copy and not data.empty())
+      {
+        throw sqlpp::exception("Sqlite3 error: Could not allocate memory to deserialize schema " + schema);
+      }
+      std::copy(data.begin(), data.end(), copy);
+      deserialize(serialized_database{copy, data.size()}, schema);
+    }
+
+    void connection::deserialize(uint8_t* data, size_t size, unsigned int flags, const std::string& schema)
+    {
+      check_serialize_support();
+      auto rc = sqlite3_deserialize(_handle->sqlite, schema.c_str(), data, static_cast<sqlite3_int64>(size),
+                                    static_cast<sqlite3_int64>(size), flags);
+      if (rc != SQLITE_OK)
+      {
+        throw sqlpp::exception("Sqlite3 error: Could not deserialize schema " + schema + ": " +
+                               std::string(sqlite3_errmsg(_handle->sqlite)));
+      }
+    }
+#endif
   }
 }
@@ -0,0 +1,228 @@
+/*
+ * Copyright (c) 2013 - 2016, Roland Bock
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ *   Redistributions of source code must retain the above copyright notice, this
+ *   list of conditions and the following disclaimer.
+ *
+ *   Redistributions in binary form must reproduce the above copyright notice, this
+ *   list of conditions and the following disclaimer in the documentation and/or
+ *   other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON
+ * ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "carray.h"
+#include <cstdint>
+#include <new>
+#include <sqlpp11/sqlite3/features.h>
+#include <string>
+#include <vector>
+
+#ifdef SQLPP_DYNAMIC_LOADING
+#include <sqlpp11/sqlite3/dynamic_libsqlite3.h>
+#endif
+
+namespace sqlpp
+{
+  namespace sqlite3
+  {
+#ifdef SQLPP_DYNAMIC_LOADING
+    using namespace dynamic;
+#endif
+
+    namespace detail
+    {
+      const char* const carray_int64_pointer_type = "sqlpp11_carray_int64";
+      const char* const carray_double_pointer_type = "sqlpp11_carray_double";
+      const char* const carray_text_pointer_type = "sqlpp11_carray_text";
+
+#if SQLITE_VERSION_NUMBER >= 3020000
+      namespace
+      {
+        enum carray_column
+        {
+          carray_value = 0,
+          carray_pointer = 1,
+        };
+
+        struct carray_cursor : public sqlite3_vtab_cursor
+        {
+          const std::vector<int64_t>* int64_values;
+          const std::vector<double>* double_values;
+          const std::vector<std::string>* text_values;
+          size_t size;
+          size_t index;
+        };
+
+        int carray_connect(::sqlite3* db, void*, int, const char* const*, sqlite3_vtab** result, char**)
+        {
+          const auto rc = sqlite3_declare_vtab(db, "CREATE TABLE x(value, pointer HIDDEN)");
+          if (rc != SQLITE_OK)
+            return rc;
+          auto table = new (std::nothrow) sqlite3_vtab();
+          if (not table)
+            return SQLITE_NOMEM;
+          *result = table;
+          return SQLITE_OK;
+        }
+
+        int carray_disconnect(sqlite3_vtab* table)
+        {
+          delete table;
+          return SQLITE_OK;
+        }
+
+        int carray_best_index(sqlite3_vtab*, sqlite3_index_info* info)
+        {
+          for (int i = 0; i < info->nConstraint; ++i)
+          {
+            const auto& constraint = info->aConstraint[i];
+            if (constraint.usable and constraint.iColumn == carray_pointer and
+                constraint.op == SQLITE_INDEX_CONSTRAINT_EQ)
+            {
+              info->aConstraintUsage[i].argvIndex = 1;
+              info->aConstraintUsage[i].omit = 1;
+              info->idxNum = 1;
+              info->estimatedCost = 1.0;
+              info->estimatedRows = 100;
+              return SQLITE_OK;
+            }
+          }
+          // without the pointer there is nothing to return
+          info->idxNum = 0;
+          info->estimatedCost = 2147483647.0;
+          info->estimatedRows = 2147483647;
+          return SQLITE_OK;
+        }
+
+        int carray_open(sqlite3_vtab*, sqlite3_vtab_cursor** result)
+        {
+          auto cursor = new (std::nothrow) carray_cursor();
+          if (not cursor)
+            return SQLITE_NOMEM;
+          *result = cursor;
+          return SQLITE_OK;
+        }
+
+        int carray_close(sqlite3_vtab_cursor* cursor)
+        {
+          delete static_cast<carray_cursor*>(cursor);
+          return SQLITE_OK;
+        }
+
+        int carray_filter(sqlite3_vtab_cursor* base, int plan, const char*, int, sqlite3_value** argv)
+        {
+          auto& cursor = *static_cast<carray_cursor*>(base);
+          cursor.int64_values = nullptr;
+          cursor.double_values = nullptr;
+          cursor.text_values = nullptr;
+          cursor.size = 0;
+          cursor.index = 0;
+          if (plan == 0)
+            return SQLITE_OK;
+
+          // sqlite3_value_pointer returns nullptr for a mismatching pointer type
+          if ((cursor.int64_values =
+                   static_cast<const std::vector<int64_t>*>(sqlite3_value_pointer(argv[0], carray_int64_pointer_type))))
+            cursor.size = cursor.int64_values->size();
+          else if ((cursor.double_values = static_cast<const std::vector<double>*>(
+                        sqlite3_value_pointer(argv[0], carray_double_pointer_type))))
+            cursor.size = cursor.double_values->size();
+          else if ((cursor.text_values = static_cast<const std::vector<std::string>*>(
+                        sqlite3_value_pointer(argv[0], carray_text_pointer_type))))
+            cursor.size = cursor.text_values->size();
+          return SQLITE_OK;
+        }
+
+        int carray_next(sqlite3_vtab_cursor* base)
+        {
+          ++static_cast<carray_cursor*>(base)->index;
+          return SQLITE_OK;
+        }
+
+        int carray_eof(sqlite3_vtab_cursor* base)
+        {
+          const auto& cursor = *static_cast<carray_cursor*>(base);
+          return cursor.index >= cursor.size;
+        }
+
+        int carray_column(sqlite3_vtab_cursor* base, sqlite3_context* context, int column)
+        {
+          const auto& cursor = *static_cast<carray_cursor*>(base);
+          if (column != carray_value)
+            sqlite3_result_null(context);
+          else if (cursor.int64_values)
+            sqlite3_result_int64(context, (*cursor.int64_values)[cursor.index]);
+          else if (cursor.double_values)
+            sqlite3_result_double(context, (*cursor.double_values)[cursor.index]);
+          else if (cursor.text_values)
+          {
+            // the bound vector stays unchanged while the statement is running
+            const auto& text = (*cursor.text_values)[cursor.index];
+            sqlite3_result_text(context, text.data(), static_cast<int>(text.size()), SQLITE_STATIC);
+          }
+          return SQLITE_OK;
+        }
+
+        int carray_rowid(sqlite3_vtab_cursor* base, sqlite3_int64* rowid)
+        {
+          *rowid = static_cast<sqlite3_int64>(static_cast<carray_cursor*>(base)->index + 1);
+          return SQLITE_OK;
+        }
+
+        sqlite3_module make_carray_module()
+        {
+          sqlite3_module module = {};
+          module.iVersion = 0;
+          module.xCreate = nullptr;  // eponymous only
+          module.xConnect = &carray_connect;
+          module.xBestIndex = &carray_best_index;
+          module.xDisconnect = &carray_disconnect;
+          module.xDestroy = &carray_disconnect;
+          module.xOpen = &carray_open;
+          module.xClose = &carray_close;
+          module.xFilter = &carray_filter;
+          module.xNext = &carray_next;
+          module.xEof = &carray_eof;
+          module.xColumn = &carray_column;
+          module.xRowid = &carray_rowid;
+          return module;
+        }
+
+        const sqlite3_module* carray_module()
+        {
+          static const sqlite3_module module = make_carray_module();
+          return &module;
+        }
+      }  // namespace
+
+      int register_carray_module(::sqlite3* db)
+      {
+        // the library in use may be older than the headers (dynamic loading)
+        if (not runtime_features().carray)
+          return SQLITE_OK;
+        return sqlite3_create_module_v2(db, "sqlpp_carray", carray_module(), nullptr, nullptr);
+      }
+#else
+      int register_carray_module(::sqlite3*)
+      {
+        // sqlite3_bind_pointer is required
+        return SQLITE_OK;
+      }
+#endif
+    }  // namespace detail
+  }    // namespace sqlite3
+}  // namespace sqlpp
@@ -27,6 +27,8 @@
 #include <memory>
 #include <sqlpp11/exception.h>
 #include <sqlpp11/sqlite3/connection_config.h>
+#include <sqlpp11/sqlite3/features.h>
+#include "carray.h"
 #include "connection_handle.h"
 
 #ifdef SQLPP_DYNAMIC_LOADING
@@ -46,10 +48,13 @@ namespace sqlpp
     {
       connection_handle::connection_handle(connection_config conf) : config(conf), sqlite(nullptr)
       {
+        if (!config.log)
+          config.log = default_logger();
 #ifdef SQLPP_DYNAMIC_LOADING
         init_sqlite("");
 #endif
-        
+        runtime_features();  // probe once, before anything selects a code path by it
+
         auto rc = sqlite3_open_v2(conf.path_to_database.c_str(), &sqlite, conf.flags,
                                   conf.vfs.empty() ? nullptr : conf.vfs.c_str());
         if (rc != SQLITE_OK)
@@ -58,6 +63,17 @@ namespace sqlpp
           sqlite3_close(sqlite);
           throw sqlpp::exception("Sqlite3 error: Can't open database: " + msg);
         }
+        if (conf.lookaside_slot_size > 0 and conf.lookaside_slot_count > 0)
+        {
+          rc = sqlite3_db_config(sqlite, SQLITE_DBCONFIG_LOOKASIDE, nullptr, conf.lookaside_slot_size,
+                                 conf.lookaside_slot_count);
+          if (rc != SQLITE_OK)
+          {
+            const std::string msg = sqlite3_errmsg(sqlite);
+            sqlite3_close(sqlite);
+            throw sqlpp::exception("Sqlite3 error: Can't configure lookaside memory: " + msg);
+          }
+        }
 #ifdef SQLITE_HAS_CODEC
         if (conf.password.size()>0)
         {
@@ -70,14 +86,22 @@ namespace sqlpp
           }
         }
 #endif
+        rc = register_carray_module(sqlite);
+        if (rc != SQLITE_OK)
+        {
+          const std::string msg = sqlite3_errmsg(sqlite);
+          sqlite3_close(sqlite);
+          throw sqlpp::exception("Sqlite3 error: Can't register carray module: " + msg);
+        }
       }
 
       connection_handle::~connection_handle()
       {
+        statement_cache.clear();  // unfinalized statements would keep the database open
         auto rc = sqlite3_close(sqlite);
         if (rc != SQLITE_OK)
         {
-          std::cerr << "Sqlite3 error: Can't close database: " << sqlite3_errmsg(sqlite) << std::endl;
+          config.log->log(log_record(log_level::error, "Can't close database: " + std::string(sqlite3_errmsg(sqlite))));
         }
       }
     }
@@ -32,7 +32,12 @@
 #else
 #include <sqlite3.h>
 #endif
+#include <map>
+#include <memory>
 #include <sqlpp11/sqlite3/connection_config.h>
+#include <sqlpp11/sqlite3/statistics.h>
+#include <string>
+#include "prepared_statement_handle.h"
 
 namespace sqlpp
 {
@@ -42,10 +47,28 @@ namespace sqlpp
 
     namespace detail
     {
+      // told about the transactions run through a connection (see change_stream), in the connection's thread
+      struct transaction_observer
+      {
+        virtual ~transaction_observer() = default;
+        // the savepoint at depth (1 for the outermost) has been created
+        virtual void savepoint_started(size_t depth) = 0;
+        // the changes made since the savepoint at depth has been created have been undone
+        virtual void rolled_back_to_savepoint(size_t depth) = 0;
+        // no transaction is open, i.e. whatever has been committed before has been committed successfully
+        virtual void committed() = 0;
+      };
+
       struct connection_handle
       {
         connection_config config;
         ::sqlite3* sqlite;
+        connection_stats last_stats;  // previous result of connection::stats(), to compute deltas
+        // transaction control statements (BEGIN, SAVEPOINT, ...), prepared on first use
+        std::map<std::string, prepared_statement_handle_t> statement_cache;
+        // per statement text, filled by prepare_statement if config.latency_histograms is set
+        std::map<std::string, std::shared_ptr<statement_latency>> latency;
+        transaction_observer* observer = nullptr;
 
         connection_handle(connection_config config);
         ~connection_handle();
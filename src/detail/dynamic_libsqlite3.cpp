@@ -28,7 +28,9 @@
 #include "sqlpp11/exception.h"
 
 #include <cassert>
+#include <mutex>
 #include <string>
+#include <vector>
 
 #if defined(__linux__) || defined(__APPLE__)
 #include <dlfcn.h>
@@ -47,11 +49,21 @@ namespace sqlpp
 #define DYNDEFINE(NAME) decltype(::NAME)* NAME
 
 #if defined(__linux__) || defined(__APPLE__)
-#define DYNLOAD(HNDL, NAME) NAME = reinterpret_cast<decltype(NAME)>(dlsym(HNDL, #NAME))
+#define DYNSYM(HNDL, NAME) dlsym(HNDL, #NAME)
 #else
-#define DYNLOAD(HNDL, NAME) NAME = reinterpret_cast<decltype(NAME)>(GetProcAddress(HNDL, #NAME))
+#define DYNSYM(HNDL, NAME) GetProcAddress(HNDL, #NAME)
 #endif
 
+// collect the names of missing functions, required ones make loading fail
+#define DYNLOAD(HNDL, NAME)                                    \
+  NAME = reinterpret_cast<decltype(NAME)>(DYNSYM(HNDL, NAME)); \
+  if (!NAME)                                                   \
+  missing_required.push_back(#NAME)
+#define DYNLOAD_OPTIONAL(HNDL, NAME)                           \
+  NAME = reinterpret_cast<decltype(NAME)>(DYNSYM(HNDL, NAME)); \
+  if (!NAME)                                                   \
+  missing_optional.push_back(#NAME)
+
       DYNDEFINE(sqlite3_open_v2);
       DYNDEFINE(sqlite3_open);
       DYNDEFINE(sqlite3_prepare_v2);
@@ -69,9 +81,7 @@ namespace sqlpp
       DYNDEFINE(sqlite3_bind_text);
       DYNDEFINE(sqlite3_bind_value);
       DYNDEFINE(sqlite3_libversion_number);
-      // DYNDEFINE(sqlite3_compileoption_used);
       DYNDEFINE(sqlite3_threadsafe);
-      // DYNDEFINE(sqlite3_close_v2);
       DYNDEFINE(sqlite3_shutdown);
       DYNDEFINE(sqlite3_config);
       DYNDEFINE(sqlite3_db_config);
@@ -86,30 +96,27 @@ namespace sqlpp
       DYNDEFINE(sqlite3_busy_timeout);
       DYNDEFINE(sqlite3_get_table);
       DYNDEFINE(sqlite3_free_table);
-      // DYNDEFINE(sqlite3_realloc64);
       DYNDEFINE(sqlite3_free);
-      // DYNDEFINE(sqlite3_msize);
       DYNDEFINE(sqlite3_memory_used);
       DYNDEFINE(sqlite3_memory_highwater);
       DYNDEFINE(sqlite3_randomness);
       DYNDEFINE(sqlite3_set_authorizer);
       DYNDEFINE(sqlite3_progress_handler);
       DYNDEFINE(sqlite3_open16);
-      // DYNDEFINE(sqlite3_uri_boolean);
-      // DYNDEFINE(sqlite3_uri_int64);
       DYNDEFINE(sqlite3_errcode);
       DYNDEFINE(sqlite3_errmsg);
+      DYNDEFINE(sqlite3_errstr);
       DYNDEFINE(sqlite3_extended_errcode);
       DYNDEFINE(sqlite3_limit);
       DYNDEFINE(sqlite3_prepare);
       DYNDEFINE(sqlite3_prepare16);
       DYNDEFINE(sqlite3_prepare16_v2);
-      // DYNDEFINE(sqlite3_stmt_readonly);
-      // DYNDEFINE(sqlite3_stmt_busy);
-      // DYNDEFINE(sqlite3_bind_blob64);
       DYNDEFINE(sqlite3_bind_text16);
-      // DYNDEFINE(sqlite3_bind_text64);
       DYNDEFINE(sqlite3_bind_zeroblob);
+#if SQLITE_VERSION_NUMBER >= 3020000
+      DYNDEFINE(sqlite3_bind_pointer);
+      DYNDEFINE(sqlite3_value_pointer);
+#endif
       DYNDEFINE(sqlite3_bind_parameter_count);
       DYNDEFINE(sqlite3_bind_parameter_index);
       DYNDEFINE(sqlite3_clear_bindings);
@@ -128,7 +135,13 @@ namespace sqlpp
       DYNDEFINE(sqlite3_reset);
       DYNDEFINE(sqlite3_create_function);
       DYNDEFINE(sqlite3_create_function16);
-      // DYNDEFINE(sqlite3_create_function_v2);
+      DYNDEFINE(sqlite3_create_function_v2);
+#if SQLITE_VERSION_NUMBER >= 3025000
+      DYNDEFINE(sqlite3_create_window_function);
+#endif
+      DYNDEFINE(sqlite3_aggregate_context);
+      DYNDEFINE(sqlite3_user_data);
+      DYNDEFINE(sqlite3_value_blob);
       DYNDEFINE(sqlite3_value_bytes);
       DYNDEFINE(sqlite3_value_bytes16);
       DYNDEFINE(sqlite3_value_double);
@@ -136,9 +149,9 @@ namespace sqlpp
       DYNDEFINE(sqlite3_value_int64);
       DYNDEFINE(sqlite3_value_type);
       DYNDEFINE(sqlite3_value_numeric_type);
+      DYNDEFINE(sqlite3_value_text);
       DYNDEFINE(sqlite3_set_auxdata);
       DYNDEFINE(sqlite3_result_blob);
-      // DYNDEFINE(sqlite3_result_blob64);
       DYNDEFINE(sqlite3_result_double);
       DYNDEFINE(sqlite3_result_error);
       DYNDEFINE(sqlite3_result_error16);
@@ -149,7 +162,6 @@ namespace sqlpp
       DYNDEFINE(sqlite3_result_int64);
       DYNDEFINE(sqlite3_result_null);
       DYNDEFINE(sqlite3_result_text);
-      // DYNDEFINE(sqlite3_result_text64);
       DYNDEFINE(sqlite3_result_text16);
       DYNDEFINE(sqlite3_result_text16le);
       DYNDEFINE(sqlite3_result_text16be);
@@ -174,17 +186,13 @@ namespace sqlpp
 #endif
       DYNDEFINE(sqlite3_sleep);
       DYNDEFINE(sqlite3_get_autocommit);
-      // DYNDEFINE(sqlite3_db_readonly);
       DYNDEFINE(sqlite3_next_stmt);
       DYNDEFINE(sqlite3_enable_shared_cache);
       DYNDEFINE(sqlite3_release_memory);
-      // DYNDEFINE(sqlite3_db_release_memory);
-      // DYNDEFINE(sqlite3_soft_heap_limit64);
       DYNDEFINE(sqlite3_table_column_metadata);
       DYNDEFINE(sqlite3_load_extension);
       DYNDEFINE(sqlite3_enable_load_extension);
       DYNDEFINE(sqlite3_auto_extension);
-      // DYNDEFINE(sqlite3_cancel_auto_extension);
       DYNDEFINE(sqlite3_reset_auto_extension);
       DYNDEFINE(sqlite3_create_module);
       DYNDEFINE(sqlite3_create_module_v2);
@@ -195,6 +203,7 @@ namespace sqlpp
       DYNDEFINE(sqlite3_blob_bytes);
       DYNDEFINE(sqlite3_blob_read);
       DYNDEFINE(sqlite3_blob_write);
+      DYNDEFINE(sqlite3_blob_reopen);
       DYNDEFINE(sqlite3_vfs_find);
       DYNDEFINE(sqlite3_vfs_register);
       DYNDEFINE(sqlite3_vfs_unregister);
@@ -203,12 +212,11 @@ namespace sqlpp
       DYNDEFINE(sqlite3_mutex_enter);
       DYNDEFINE(sqlite3_mutex_try);
       DYNDEFINE(sqlite3_mutex_leave);
-      // DYNDEFINE(sqlite3_mutex_held);
-      // DYNDEFINE(sqlite3_mutex_notheld);
       DYNDEFINE(sqlite3_db_mutex);
       DYNDEFINE(sqlite3_file_control);
       DYNDEFINE(sqlite3_test_control);
       DYNDEFINE(sqlite3_status);
+      DYNDEFINE(sqlite3_status64);
       DYNDEFINE(sqlite3_db_status);
       DYNDEFINE(sqlite3_stmt_status);
       DYNDEFINE(sqlite3_backup_init);
@@ -217,17 +225,77 @@ namespace sqlpp
       DYNDEFINE(sqlite3_backup_remaining);
       DYNDEFINE(sqlite3_backup_pagecount);
       DYNDEFINE(sqlite3_unlock_notify);
-// DYNDEFINE(sqlite3_stricmp);
-// DYNDEFINE(sqlite3_strnicmp);
-// DYNDEFINE(sqlite3_strglob);
-// DYNDEFINE(sqlite3_log);
-// DYNDEFINE(sqlite3_wal_autocheckpoint);
-// DYNDEFINE(sqlite3_wal_checkpoint);
-// DYNDEFINE(sqlite3_wal_checkpoint_v2);
-// DYNDEFINE(sqlite3_vtab_config);
-// DYNDEFINE(sqlite3_vtab_on_conflict);
-// DYNDEFINE(sqlite3_rtree_geometry_callback);
-// DYNDEFINE(sqlite3_rtree_query_callback);
+#if SQLITE_VERSION_NUMBER >= 3036000
+      DYNDEFINE(sqlite3_malloc64);
+      DYNDEFINE(sqlite3_serialize);
+      DYNDEFINE(sqlite3_deserialize);
+#endif
+      DYNDEFINE(sqlite3_wal_autocheckpoint);
+      DYNDEFINE(sqlite3_wal_checkpoint_v2);
+      DYNDEFINE(sqlite3_wal_hook);
+      DYNDEFINE(sqlite3_commit_hook);
+      DYNDEFINE(sqlite3_rollback_hook);
+
+      // optional
+      DYNDEFINE(sqlite3_compileoption_used);
+      DYNDEFINE(sqlite3_compileoption_get);
+      DYNDEFINE(sqlite3_libversion);
+      DYNDEFINE(sqlite3_sourceid);
+      DYNDEFINE(sqlite3_log);
+      DYNDEFINE(sqlite3_vtab_config);
+      DYNDEFINE(sqlite3_vtab_on_conflict);
+      DYNDEFINE(sqlite3_rtree_geometry_callback);
+      DYNDEFINE(sqlite3_mutex_held);
+      DYNDEFINE(sqlite3_mutex_notheld);
+#if SQLITE_VERSION_NUMBER >= 3008007
+      DYNDEFINE(sqlite3_close_v2);
+      DYNDEFINE(sqlite3_realloc64);
+      DYNDEFINE(sqlite3_msize);
+      DYNDEFINE(sqlite3_uri_boolean);
+      DYNDEFINE(sqlite3_uri_int64);
+      DYNDEFINE(sqlite3_stmt_readonly);
+      DYNDEFINE(sqlite3_stmt_busy);
+      DYNDEFINE(sqlite3_bind_blob64);
+      DYNDEFINE(sqlite3_bind_text64);
+      DYNDEFINE(sqlite3_result_blob64);
+      DYNDEFINE(sqlite3_result_text64);
+      DYNDEFINE(sqlite3_db_readonly);
+      DYNDEFINE(sqlite3_db_release_memory);
+      DYNDEFINE(sqlite3_soft_heap_limit64);
+      DYNDEFINE(sqlite3_cancel_auto_extension);
+      DYNDEFINE(sqlite3_stricmp);
+      DYNDEFINE(sqlite3_strnicmp);
+      DYNDEFINE(sqlite3_strglob);
+      DYNDEFINE(sqlite3_wal_checkpoint);
+      DYNDEFINE(sqlite3_rtree_query_callback);
+#endif
+#if SQLITE_VERSION_NUMBER >= 3010000
+      DYNDEFINE(sqlite3_snapshot_get);
+      DYNDEFINE(sqlite3_snapshot_open);
+      DYNDEFINE(sqlite3_snapshot_free);
+#endif
+#if SQLITE_VERSION_NUMBER >= 3014000
+      DYNDEFINE(sqlite3_trace_v2);
+      DYNDEFINE(sqlite3_expanded_sql);
+#endif
+#if SQLITE_VERSION_NUMBER >= 3020000
+      DYNDEFINE(sqlite3_prepare_v3);
+#endif
+#ifdef SQLITE_ENABLE_SESSION
+      DYNDEFINE(sqlite3session_create);
+      DYNDEFINE(sqlite3session_delete);
+      DYNDEFINE(sqlite3session_attach);
+      DYNDEFINE(sqlite3session_changeset);
+      DYNDEFINE(sqlite3session_isempty);
+      DYNDEFINE(sqlite3changeset_apply);
+      DYNDEFINE(sqlite3changeset_op);
+#endif
+#ifdef SQLITE_ENABLE_PREUPDATE_HOOK
+      DYNDEFINE(sqlite3_preupdate_hook);
+      DYNDEFINE(sqlite3_preupdate_old);
+      DYNDEFINE(sqlite3_preupdate_new);
+      DYNDEFINE(sqlite3_preupdate_count);
+#endif
 
 #define STR(x) #x
 #define GET_STR(x) STR(x)
@@ -240,227 +308,313 @@ namespace sqlpp
 #endif
 #endif
 
-      void init_sqlite(std::string libname)
+      namespace
       {
-        if (libname.empty())
+        std::once_flag load_flag;
+        std::mutex missing_mutex;
+        std::vector<std::string> missing_optional_symbols;
+
+        void load_sqlite(std::string libname)
         {
-          libname = GET_STR(SQLPP_DYNAMIC_LOADING_FILENAME);
-        }
+          if (libname.empty())
+          {
+            libname = GET_STR(SQLPP_DYNAMIC_LOADING_FILENAME);
+          }
 #if defined(__linux__) || defined(__APPLE__)
-        void* handle = nullptr;
-        handle = dlopen(libname.c_str(), RTLD_LAZY | RTLD_GLOBAL);
+          void* handle = nullptr;
+          handle = dlopen(libname.c_str(), RTLD_LAZY | RTLD_GLOBAL);
 #else
-        HINSTANCE handle = nullptr;
-        handle = LoadLibrary(libname.c_str());
+          HINSTANCE handle = nullptr;
+          handle = LoadLibrary(libname.c_str());
 #endif
 
 #undef STR
 #undef GET_STR
 
-        if (!handle)
-        {
+          if (!handle)
+          {
 #if defined(__linux__) || defined(__APPLE__)
-          throw sqlpp::exception(std::string("Could not load library " + libname + ": ").append(dlerror()));
+            throw sqlpp::exception(std::string("Could not load library " + libname + ": ").append(dlerror()));
 #elif defined(_WIN32)
-          if (GetLastError() == 193)
-          {
-            throw sqlpp::exception(
-                "Could not load SQLite library - error code indicates you are mixing 32/64 bit DLLs (lib: " + libname +
-                ")");
-          }
-          else
-          {
-            throw sqlpp::exception("Could not load lib using LoadLibrary (" + libname + ")");
-          }
+            if (GetLastError() == 193)
+            {
+              throw sqlpp::exception(
+                  "Could not load SQLite library - error code indicates you are mixing 32/64 bit DLLs (lib: " + libname +
+                  ")");
+            }
+            else
+            {
+              throw sqlpp::exception("Could not load lib using LoadLibrary (" + libname + ")");
+            }
 #endif
-        }
+          }
+
+          std::vector<std::string> missing_required;
+          std::vector<std::string> missing_optional;
 
-        DYNLOAD(handle, sqlite3_libversion_number);
-        //   DYNLOAD(handle, sqlite3_compileoption_used);
-        DYNLOAD(handle, sqlite3_threadsafe);
-        DYNLOAD(handle, sqlite3_close);
-        //   DYNLOAD(handle, sqlite3_close_v2);
-        DYNLOAD(handle, sqlite3_exec);
-        DYNLOAD(handle, sqlite3_initialize);
-        DYNLOAD(handle, sqlite3_shutdown);
-        DYNLOAD(handle, sqlite3_os_init);
-        DYNLOAD(handle, sqlite3_os_end);
-        DYNLOAD(handle, sqlite3_config);
-        DYNLOAD(handle, sqlite3_db_config);
-        DYNLOAD(handle, sqlite3_extended_result_codes);
-        DYNLOAD(handle, sqlite3_last_insert_rowid);
-        DYNLOAD(handle, sqlite3_changes);
-        DYNLOAD(handle, sqlite3_total_changes);
-        DYNLOAD(handle, sqlite3_interrupt);
-        DYNLOAD(handle, sqlite3_complete);
-        DYNLOAD(handle, sqlite3_complete16);
-        DYNLOAD(handle, sqlite3_busy_handler);
-        DYNLOAD(handle, sqlite3_busy_timeout);
-        DYNLOAD(handle, sqlite3_get_table);
-        DYNLOAD(handle, sqlite3_free_table);
-        //   DYNLOAD(handle, sqlite3_realloc64);
-        DYNLOAD(handle, sqlite3_free);
-        //   DYNLOAD(handle, sqlite3_msize);
-        DYNLOAD(handle, sqlite3_memory_used);
-        DYNLOAD(handle, sqlite3_memory_highwater);
-        DYNLOAD(handle, sqlite3_randomness);
-        DYNLOAD(handle, sqlite3_set_authorizer);
-        DYNLOAD(handle, sqlite3_progress_handler);
-        DYNLOAD(handle, sqlite3_open);
-        DYNLOAD(handle, sqlite3_open16);
-        DYNLOAD(handle, sqlite3_open_v2);
-        //   DYNLOAD(handle, sqlite3_uri_boolean);
-        //   DYNLOAD(handle, sqlite3_uri_int64);
-        DYNLOAD(handle, sqlite3_errcode);
-        DYNLOAD(handle, sqlite3_errmsg);
-        DYNLOAD(handle, sqlite3_extended_errcode);
-        DYNLOAD(handle, sqlite3_limit);
-        DYNLOAD(handle, sqlite3_prepare);
-        DYNLOAD(handle, sqlite3_prepare_v2);
-        DYNLOAD(handle, sqlite3_prepare16);
-        DYNLOAD(handle, sqlite3_prepare16_v2);
-        //   DYNLOAD(handle, sqlite3_stmt_readonly);
-        //   DYNLOAD(handle, sqlite3_stmt_busy);
-        DYNLOAD(handle, sqlite3_bind_blob);
-        //   DYNLOAD(handle, sqlite3_bind_blob64);
-        DYNLOAD(handle, sqlite3_bind_double);
-        DYNLOAD(handle, sqlite3_bind_int);
-        DYNLOAD(handle, sqlite3_bind_int64);
-        DYNLOAD(handle, sqlite3_bind_null);
-        DYNLOAD(handle, sqlite3_bind_text);
-        DYNLOAD(handle, sqlite3_bind_text16);
-        //   DYNLOAD(handle, sqlite3_bind_text64);
-        DYNLOAD(handle, sqlite3_bind_value);
-        DYNLOAD(handle, sqlite3_bind_zeroblob);
-        DYNLOAD(handle, sqlite3_bind_parameter_count);
-        DYNLOAD(handle, sqlite3_bind_parameter_index);
-        DYNLOAD(handle, sqlite3_clear_bindings);
-        DYNLOAD(handle, sqlite3_column_count);
-        DYNLOAD(handle, sqlite3_step);
-        DYNLOAD(handle, sqlite3_data_count);
-        DYNLOAD(handle, sqlite3_column_bytes);
-        DYNLOAD(handle, sqlite3_column_bytes16);
-        DYNLOAD(handle, sqlite3_column_double);
-        DYNLOAD(handle, sqlite3_column_int);
-        DYNLOAD(handle, sqlite3_column_int64);
-        DYNLOAD(handle, sqlite3_column_text);
-        DYNLOAD(handle, sqlite3_column_type);
-        DYNLOAD(handle, sqlite3_column_value);
-        DYNLOAD(handle, sqlite3_column_blob);
-        DYNLOAD(handle, sqlite3_finalize);
-        DYNLOAD(handle, sqlite3_reset);
-        DYNLOAD(handle, sqlite3_create_function);
-        DYNLOAD(handle, sqlite3_create_function16);
-        //   DYNLOAD(handle, sqlite3_create_function_v2);
-        DYNLOAD(handle, sqlite3_value_bytes);
-        DYNLOAD(handle, sqlite3_value_bytes16);
-        DYNLOAD(handle, sqlite3_value_double);
-        DYNLOAD(handle, sqlite3_value_int);
-        DYNLOAD(handle, sqlite3_value_int64);
-        DYNLOAD(handle, sqlite3_value_type);
-        DYNLOAD(handle, sqlite3_value_numeric_type);
-        DYNLOAD(handle, sqlite3_set_auxdata);
-        DYNLOAD(handle, sqlite3_result_blob);
-        //   DYNLOAD(handle, sqlite3_result_blob64);
-        DYNLOAD(handle, sqlite3_result_double);
-        DYNLOAD(handle, sqlite3_result_error);
-        DYNLOAD(handle, sqlite3_result_error16);
-        DYNLOAD(handle, sqlite3_result_error_toobig);
-        DYNLOAD(handle, sqlite3_result_error_nomem);
-        DYNLOAD(handle, sqlite3_result_error_code);
-        DYNLOAD(handle, sqlite3_result_int);
-        DYNLOAD(handle, sqlite3_result_int64);
-        DYNLOAD(handle, sqlite3_result_null);
-        DYNLOAD(handle, sqlite3_result_text);
-        //   DYNLOAD(handle, sqlite3_result_text64);
-        DYNLOAD(handle, sqlite3_result_text16);
-        DYNLOAD(handle, sqlite3_result_text16le);
-        DYNLOAD(handle, sqlite3_result_text16be);
-        DYNLOAD(handle, sqlite3_result_value);
-        DYNLOAD(handle, sqlite3_result_zeroblob);
-        DYNLOAD(handle, sqlite3_create_collation);
-        DYNLOAD(handle, sqlite3_create_collation_v2);
-        DYNLOAD(handle, sqlite3_create_collation16);
-        DYNLOAD(handle, sqlite3_collation_needed);
-        DYNLOAD(handle, sqlite3_collation_needed16);
+          DYNLOAD(handle, sqlite3_libversion_number);
+          DYNLOAD(handle, sqlite3_threadsafe);
+          DYNLOAD(handle, sqlite3_close);
+          DYNLOAD(handle, sqlite3_exec);
+          DYNLOAD(handle, sqlite3_initialize);
+          DYNLOAD(handle, sqlite3_shutdown);
+          DYNLOAD(handle, sqlite3_os_init);
+          DYNLOAD(handle, sqlite3_os_end);
+          DYNLOAD(handle, sqlite3_config);
+          DYNLOAD(handle, sqlite3_db_config);
+          DYNLOAD(handle, sqlite3_extended_result_codes);
+          DYNLOAD(handle, sqlite3_last_insert_rowid);
+          DYNLOAD(handle, sqlite3_changes);
+          DYNLOAD(handle, sqlite3_total_changes);
+          DYNLOAD(handle, sqlite3_interrupt);
+          DYNLOAD(handle, sqlite3_complete);
+          DYNLOAD(handle, sqlite3_complete16);
+          DYNLOAD(handle, sqlite3_busy_handler);
+          DYNLOAD(handle, sqlite3_busy_timeout);
+          DYNLOAD(handle, sqlite3_get_table);
+          DYNLOAD(handle, sqlite3_free_table);
+          DYNLOAD(handle, sqlite3_free);
+          DYNLOAD(handle, sqlite3_memory_used);
+          DYNLOAD(handle, sqlite3_memory_highwater);
+          DYNLOAD(handle, sqlite3_randomness);
+          DYNLOAD(handle, sqlite3_set_authorizer);
+          DYNLOAD(handle, sqlite3_progress_handler);
+          DYNLOAD(handle, sqlite3_open);
+          DYNLOAD(handle, sqlite3_open16);
+          DYNLOAD(handle, sqlite3_open_v2);
+          DYNLOAD(handle, sqlite3_errcode);
+          DYNLOAD(handle, sqlite3_errmsg);
+          DYNLOAD(handle, sqlite3_errstr);
+          DYNLOAD(handle, sqlite3_extended_errcode);
+          DYNLOAD(handle, sqlite3_limit);
+          DYNLOAD(handle, sqlite3_prepare);
+          DYNLOAD(handle, sqlite3_prepare_v2);
+          DYNLOAD(handle, sqlite3_prepare16);
+          DYNLOAD(handle, sqlite3_prepare16_v2);
+          DYNLOAD(handle, sqlite3_bind_blob);
+          DYNLOAD(handle, sqlite3_bind_double);
+          DYNLOAD(handle, sqlite3_bind_int);
+          DYNLOAD(handle, sqlite3_bind_int64);
+          DYNLOAD(handle, sqlite3_bind_null);
+          DYNLOAD(handle, sqlite3_bind_text);
+          DYNLOAD(handle, sqlite3_bind_text16);
+          DYNLOAD(handle, sqlite3_bind_value);
+          DYNLOAD(handle, sqlite3_bind_zeroblob);
+#if SQLITE_VERSION_NUMBER >= 3020000
+          DYNLOAD_OPTIONAL(handle, sqlite3_bind_pointer);
+          DYNLOAD_OPTIONAL(handle, sqlite3_value_pointer);
+#endif
+          DYNLOAD(handle, sqlite3_bind_parameter_count);
+          DYNLOAD(handle, sqlite3_bind_parameter_index);
+          DYNLOAD(handle, sqlite3_clear_bindings);
+          DYNLOAD(handle, sqlite3_column_count);
+          DYNLOAD(handle, sqlite3_step);
+          DYNLOAD(handle, sqlite3_data_count);
+          DYNLOAD(handle, sqlite3_column_bytes);
+          DYNLOAD(handle, sqlite3_column_bytes16);
+          DYNLOAD(handle, sqlite3_column_double);
+          DYNLOAD(handle, sqlite3_column_int);
+          DYNLOAD(handle, sqlite3_column_int64);
+          DYNLOAD(handle, sqlite3_column_text);
+          DYNLOAD(handle, sqlite3_column_type);
+          DYNLOAD(handle, sqlite3_column_value);
+          DYNLOAD(handle, sqlite3_column_blob);
+          DYNLOAD(handle, sqlite3_finalize);
+          DYNLOAD(handle, sqlite3_reset);
+          DYNLOAD(handle, sqlite3_create_function);
+          DYNLOAD(handle, sqlite3_create_function16);
+          DYNLOAD(handle, sqlite3_create_function_v2);
+#if SQLITE_VERSION_NUMBER >= 3025000
+          DYNLOAD_OPTIONAL(handle, sqlite3_create_window_function);
+#endif
+          DYNLOAD(handle, sqlite3_aggregate_context);
+          DYNLOAD(handle, sqlite3_user_data);
+          DYNLOAD(handle, sqlite3_value_blob);
+          DYNLOAD(handle, sqlite3_value_bytes);
+          DYNLOAD(handle, sqlite3_value_bytes16);
+          DYNLOAD(handle, sqlite3_value_double);
+          DYNLOAD(handle, sqlite3_value_int);
+          DYNLOAD(handle, sqlite3_value_int64);
+          DYNLOAD(handle, sqlite3_value_type);
+          DYNLOAD(handle, sqlite3_value_numeric_type);
+          DYNLOAD(handle, sqlite3_value_text);
+          DYNLOAD(handle, sqlite3_set_auxdata);
+          DYNLOAD(handle, sqlite3_result_blob);
+          DYNLOAD(handle, sqlite3_result_double);
+          DYNLOAD(handle, sqlite3_result_error);
+          DYNLOAD(handle, sqlite3_result_error16);
+          DYNLOAD(handle, sqlite3_result_error_toobig);
+          DYNLOAD(handle, sqlite3_result_error_nomem);
+          DYNLOAD(handle, sqlite3_result_error_code);
+          DYNLOAD(handle, sqlite3_result_int);
+          DYNLOAD(handle, sqlite3_result_int64);
+          DYNLOAD(handle, sqlite3_result_null);
+          DYNLOAD(handle, sqlite3_result_text);
+          DYNLOAD(handle, sqlite3_result_text16);
+          DYNLOAD(handle, sqlite3_result_text16le);
+          DYNLOAD(handle, sqlite3_result_text16be);
+          DYNLOAD(handle, sqlite3_result_value);
+          DYNLOAD(handle, sqlite3_result_zeroblob);
+          DYNLOAD(handle, sqlite3_create_collation);
+          DYNLOAD(handle, sqlite3_create_collation_v2);
+          DYNLOAD(handle, sqlite3_create_collation16);
+          DYNLOAD(handle, sqlite3_collation_needed);
+          DYNLOAD(handle, sqlite3_collation_needed16);
 
 #ifdef SQLITE_HAS_CODEC
-        DYNLOAD(handle, sqlite3_key);
-        DYNLOAD(handle, sqlite3_key_v2);
-        DYNLOAD(handle, sqlite3_rekey);
-        DYNLOAD(handle, sqlite3_rekey_v2);
-        DYNLOAD(handle, sqlite3_activate_see);
+          DYNLOAD_OPTIONAL(handle, sqlite3_key);
+          DYNLOAD_OPTIONAL(handle, sqlite3_key_v2);
+          DYNLOAD_OPTIONAL(handle, sqlite3_rekey);
+          DYNLOAD_OPTIONAL(handle, sqlite3_rekey_v2);
+          DYNLOAD_OPTIONAL(handle, sqlite3_activate_see);
 #endif
 #ifdef SQLITE_ENABLE_CEROD
-        DYNLOAD(handle, sqlite3_activate_cerod);
+          DYNLOAD_OPTIONAL(handle, sqlite3_activate_cerod);
+#endif
+          DYNLOAD(handle, sqlite3_sleep);
+          DYNLOAD(handle, sqlite3_get_autocommit);
+          DYNLOAD(handle, sqlite3_next_stmt);
+          DYNLOAD(handle, sqlite3_enable_shared_cache);
+          DYNLOAD(handle, sqlite3_release_memory);
+          DYNLOAD(handle, sqlite3_table_column_metadata);
+          DYNLOAD(handle, sqlite3_load_extension);
+          DYNLOAD(handle, sqlite3_enable_load_extension);
+          DYNLOAD(handle, sqlite3_auto_extension);
+          DYNLOAD(handle, sqlite3_reset_auto_extension);
+          DYNLOAD(handle, sqlite3_create_module);
+          DYNLOAD(handle, sqlite3_create_module_v2);
+          DYNLOAD(handle, sqlite3_declare_vtab);
+          DYNLOAD(handle, sqlite3_overload_function);
+          DYNLOAD(handle, sqlite3_blob_open);
+          DYNLOAD(handle, sqlite3_blob_close);
+          DYNLOAD(handle, sqlite3_blob_bytes);
+          DYNLOAD(handle, sqlite3_blob_read);
+          DYNLOAD(handle, sqlite3_blob_write);
+          DYNLOAD(handle, sqlite3_blob_reopen);
+          DYNLOAD(handle, sqlite3_vfs_find);
+          DYNLOAD(handle, sqlite3_vfs_register);
+          DYNLOAD(handle, sqlite3_vfs_unregister);
+          DYNLOAD(handle, sqlite3_mutex_alloc);
+          DYNLOAD(handle, sqlite3_mutex_free);
+          DYNLOAD(handle, sqlite3_mutex_enter);
+          DYNLOAD(handle, sqlite3_mutex_try);
+          DYNLOAD(handle, sqlite3_mutex_leave);
+          DYNLOAD(handle, sqlite3_db_mutex);
+          DYNLOAD(handle, sqlite3_file_control);
+          DYNLOAD(handle, sqlite3_test_control);
+          DYNLOAD(handle, sqlite3_status);
+          DYNLOAD(handle, sqlite3_status64);
+          DYNLOAD(handle, sqlite3_db_status);
+          DYNLOAD(handle, sqlite3_stmt_status);
+          DYNLOAD(handle, sqlite3_backup_init);
+          DYNLOAD(handle, sqlite3_backup_step);
+          DYNLOAD(handle, sqlite3_backup_finish);
+          DYNLOAD(handle, sqlite3_backup_remaining);
+          DYNLOAD(handle, sqlite3_backup_pagecount);
+          DYNLOAD_OPTIONAL(handle, sqlite3_unlock_notify);
+#if SQLITE_VERSION_NUMBER >= 3036000
+          DYNLOAD_OPTIONAL(handle, sqlite3_malloc64);
+          DYNLOAD_OPTIONAL(handle, sqlite3_serialize);
+          DYNLOAD_OPTIONAL(handle, sqlite3_deserialize);
 #endif
-        DYNLOAD(handle, sqlite3_sleep);
-        DYNLOAD(handle, sqlite3_get_autocommit);
-        //   DYNLOAD(handle, sqlite3_db_readonly);
-        DYNLOAD(handle, sqlite3_next_stmt);
-        DYNLOAD(handle, sqlite3_enable_shared_cache);
-        DYNLOAD(handle, sqlite3_release_memory);
-        //   DYNLOAD(handle, sqlite3_db_release_memory);
-        //   DYNLOAD(handle, sqlite3_soft_heap_limit64);
-        DYNLOAD(handle, sqlite3_table_column_metadata);
-        DYNLOAD(handle, sqlite3_load_extension);
-        DYNLOAD(handle, sqlite3_enable_load_extension);
-        DYNLOAD(handle, sqlite3_auto_extension);
-        //   DYNLOAD(handle, sqlite3_cancel_auto_extension);
-        DYNLOAD(handle, sqlite3_reset_auto_extension);
-        DYNLOAD(handle, sqlite3_create_module);
-        DYNLOAD(handle, sqlite3_create_module_v2);
-        DYNLOAD(handle, sqlite3_declare_vtab);
-        DYNLOAD(handle, sqlite3_overload_function);
-        DYNLOAD(handle, sqlite3_blob_open);
-        DYNLOAD(handle, sqlite3_blob_close);
-        DYNLOAD(handle, sqlite3_blob_bytes);
-        DYNLOAD(handle, sqlite3_blob_read);
-        DYNLOAD(handle, sqlite3_blob_write);
-        DYNLOAD(handle, sqlite3_vfs_find);
-        DYNLOAD(handle, sqlite3_vfs_register);
-        DYNLOAD(handle, sqlite3_vfs_unregister);
-        DYNLOAD(handle, sqlite3_mutex_alloc);
-        DYNLOAD(handle, sqlite3_mutex_free);
-        DYNLOAD(handle, sqlite3_mutex_enter);
-        DYNLOAD(handle, sqlite3_mutex_try);
-        DYNLOAD(handle, sqlite3_mutex_leave);
-        // DYNLOAD(handle, sqlite3_mutex_held);
-        // DYNLOAD(handle, sqlite3_mutex_notheld);
-        DYNLOAD(handle, sqlite3_db_mutex);
-        DYNLOAD(handle, sqlite3_file_control);
-        DYNLOAD(handle, sqlite3_test_control);
-        DYNLOAD(handle, sqlite3_status);
-        DYNLOAD(handle, sqlite3_db_status);
-        DYNLOAD(handle, sqlite3_stmt_status);
-        DYNLOAD(handle, sqlite3_backup_init);
-        DYNLOAD(handle, sqlite3_backup_step);
-        DYNLOAD(handle, sqlite3_backup_finish);
-        DYNLOAD(handle, sqlite3_backup_remaining);
-        DYNLOAD(handle, sqlite3_backup_pagecount);
-        DYNLOAD(handle, sqlite3_unlock_notify);
-        //   DYNLOAD(handle, sqlite3_stricmp);
-        //   DYNLOAD(handle, sqlite3_strnicmp);
-        //   DYNLOAD(handle, sqlite3_strglob);
-        //   DYNLOAD(handle, sqlite3_log);
-        //   DYNLOAD(handle, sqlite3_wal_autocheckpoint);
-        //   DYNLOAD(handle, sqlite3_wal_checkpoint);
-        //   DYNLOAD(handle, sqlite3_wal_checkpoint_v2);
-        //   DYNLOAD(handle, sqlite3_vtab_config);
-        //   DYNLOAD(handle, sqlite3_vtab_on_conflict);
-        //   DYNLOAD(handle, sqlite3_rtree_geometry_callback);
-        //   DYNLOAD(handle, sqlite3_rtree_query_callback);
+          DYNLOAD(handle, sqlite3_wal_autocheckpoint);
+          DYNLOAD(handle, sqlite3_wal_checkpoint_v2);
+          DYNLOAD(handle, sqlite3_wal_hook);
+          DYNLOAD(handle, sqlite3_commit_hook);
+          DYNLOAD(handle, sqlite3_rollback_hook);
 
-        // check some functions for nullptr to verify if loading worked, otherwise throw
-        if (sqlite3_shutdown == nullptr || sqlite3_exec == nullptr)
-        {
-          throw sqlpp::exception("Initializing dynamically loaded SQLite3 functions failed");
+          DYNLOAD_OPTIONAL(handle, sqlite3_compileoption_used);
+          DYNLOAD_OPTIONAL(handle, sqlite3_compileoption_get);
+          DYNLOAD_OPTIONAL(handle, sqlite3_libversion);
+          DYNLOAD_OPTIONAL(handle, sqlite3_sourceid);
+          DYNLOAD_OPTIONAL(handle, sqlite3_log);
+          DYNLOAD_OPTIONAL(handle, sqlite3_vtab_config);
+          DYNLOAD_OPTIONAL(handle, sqlite3_vtab_on_conflict);
+          DYNLOAD_OPTIONAL(handle, sqlite3_rtree_geometry_callback);
+          DYNLOAD_OPTIONAL(handle, sqlite3_mutex_held);
+          DYNLOAD_OPTIONAL(handle, sqlite3_mutex_notheld);
+#if SQLITE_VERSION_NUMBER >= 3008007
+          DYNLOAD_OPTIONAL(handle, sqlite3_close_v2);
+          DYNLOAD_OPTIONAL(handle, sqlite3_realloc64);
+          DYNLOAD_OPTIONAL(handle, sqlite3_msize);
+          DYNLOAD_OPTIONAL(handle, sqlite3_uri_boolean);
+          DYNLOAD_OPTIONAL(handle, sqlite3_uri_int64);
+          DYNLOAD_OPTIONAL(handle, sqlite3_stmt_readonly);
+          DYNLOAD_OPTIONAL(handle, sqlite3_stmt_busy);
+          DYNLOAD_OPTIONAL(handle, sqlite3_bind_blob64);
+          DYNLOAD_OPTIONAL(handle, sqlite3_bind_text64);
+          DYNLOAD_OPTIONAL(handle, sqlite3_result_blob64);
+          DYNLOAD_OPTIONAL(handle, sqlite3_result_text64);
+          DYNLOAD_OPTIONAL(handle, sqlite3_db_readonly);
+          DYNLOAD_OPTIONAL(handle, sqlite3_db_release_memory);
+          DYNLOAD_OPTIONAL(handle, sqlite3_soft_heap_limit64);
+          DYNLOAD_OPTIONAL(handle, sqlite3_cancel_auto_extension);
+          DYNLOAD_OPTIONAL(handle, sqlite3_stricmp);
+          DYNLOAD_OPTIONAL(handle, sqlite3_strnicmp);
+          DYNLOAD_OPTIONAL(handle, sqlite3_strglob);
+          DYNLOAD_OPTIONAL(handle, sqlite3_wal_checkpoint);
+          DYNLOAD_OPTIONAL(handle, sqlite3_rtree_query_callback);
+#endif
+#if SQLITE_VERSION_NUMBER >= 3010000
+          DYNLOAD_OPTIONAL(handle, sqlite3_snapshot_get);
+          DYNLOAD_OPTIONAL(handle, sqlite3_snapshot_open);
+          DYNLOAD_OPTIONAL(handle, sqlite3_snapshot_free);
+#endif
+#if SQLITE_VERSION_NUMBER >= 3014000
+          DYNLOAD_OPTIONAL(handle, sqlite3_trace_v2);
+          DYNLOAD_OPTIONAL(handle, sqlite3_expanded_sql);
+#endif
+#if SQLITE_VERSION_NUMBER >= 3020000
+          DYNLOAD_OPTIONAL(handle, sqlite3_prepare_v3);
+#endif
+#ifdef SQLITE_ENABLE_SESSION
+          DYNLOAD_OPTIONAL(handle, sqlite3session_create);
+          DYNLOAD_OPTIONAL(handle, sqlite3session_delete);
+          DYNLOAD_OPTIONAL(handle, sqlite3session_attach);
+          DYNLOAD_OPTIONAL(handle, sqlite3session_changeset);
+          DYNLOAD_OPTIONAL(handle, sqlite3session_isempty);
+          DYNLOAD_OPTIONAL(handle, sqlite3changeset_apply);
+          DYNLOAD_OPTIONAL(handle, sqlite3changeset_op);
+#endif
+#ifdef SQLITE_ENABLE_PREUPDATE_HOOK
+          DYNLOAD_OPTIONAL(handle, sqlite3_preupdate_hook);
+          DYNLOAD_OPTIONAL(handle, sqlite3_preupdate_old);
+          DYNLOAD_OPTIONAL(handle, sqlite3_preupdate_new);
+          DYNLOAD_OPTIONAL(handle, sqlite3_preupdate_count);
+#endif
+
+          if (!missing_required.empty())
+          {
+            std::string names;
+            for (const auto& name : missing_required)
+            {
+              names += (names.empty() ? "" : ", ") + name;
+            }
+            throw sqlpp::exception("Initializing dynamically loaded SQLite3 functions failed, missing: " + names);
+          }
+
+          std::lock_guard<std::mutex> lock(missing_mutex);
+          missing_optional_symbols = std::move(missing_optional);
         }
+      }  // namespace
+
+      void init_sqlite(std::string libname)
+      {
+        // a failed attempt leaves the flag unset, so loading can be retried
+        std::call_once(load_flag, load_sqlite, std::move(libname));
+      }
+
+      std::vector<std::string> missing_symbols()
+      {
+        std::lock_guard<std::mutex> lock(missing_mutex);
+        return missing_optional_symbols;
       }
     }  // dynamic
   }    // sqlite3
 }  // sqlpp
 
 #undef DYNDEFINE
+#undef DYNSYM
 #undef DYNLOAD
+#undef DYNLOAD_OPTIONAL
 #endif
@@ -0,0 +1,77 @@
+/*
+ * Copyright (c) 2013 - 2016, Roland Bock
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ *   Redistributions of source code must retain the above copyright notice, this
+ *   list of conditions and the following disclaimer.
+ *
+ *   Redistributions in binary form must reproduce the above copyright notice, this
+ *   list of conditions and the following disclaimer in the documentation and/or
+ *   other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON
+ * ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef SQLPP_SQLITE3_DETAIL_LATENCY_TIMER_H
+#define SQLPP_SQLITE3_DETAIL_LATENCY_TIMER_H
+
+#include <chrono>
+#include <sqlpp11/sqlite3/latency.h>
+
+namespace sqlpp
+{
+  namespace sqlite3
+  {
+    namespace detail
+    {
+      // records the time until the end of its scope in one phase of a statement_latency, does nothing (not even
+      // reading the clock) if latency is nullptr, i.e. if connection_config::latency_histograms is not set
+      class phase_timer
+      {
+        using clock = std::chrono::steady_clock;
+
+        statement_latency* _latency;
+        latency_histogram statement_latency::*_phase;
+        clock::time_point _start;
+
+      public:
+        phase_timer(statement_latency* latency, latency_histogram statement_latency::*phase)
+            : _latency(latency), _phase(phase), _start(latency ? clock::now() : clock::time_point{})
+        {
+        }
+
+        phase_timer(const phase_timer&) = delete;
+        phase_timer& operator=(const phase_timer&) = delete;
+
+        ~phase_timer()
+        {
+          if (!_latency)
+            return;
+          const auto elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(clock::now() - _start).count();
+          try
+          {
+            (_latency->*_phase).record(static_cast<uint64_t>(elapsed));
+          }
+          catch (...)
+          {
+            // allocating the buckets failed, lose the sample rather than the statement
+          }
+        }
+      };
+    }  // namespace detail
+  }    // namespace sqlite3
+}  // namespace sqlpp
+
+#endif
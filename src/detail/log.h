@@ -0,0 +1,70 @@
+/*
+ * Copyright (c) 2013 - 2016, Roland Bock
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ *   Redistributions of source code must retain the above copyright notice, this
+ *   list of conditions and the following disclaimer.
+ *
+ *   Redistributions in binary form must reproduce the above copyright notice, this
+ *   list of conditions and the following disclaimer in the documentation and/or
+ *   other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON
+ * ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef SQLPP_SQLITE3_DETAIL_LOG_H
+#define SQLPP_SQLITE3_DETAIL_LOG_H
+
+#include <sqlpp11/sqlite3/logger.h>
+#include <sstream>
+#include "prepared_statement_handle.h"
+
+namespace sqlpp
+{
+  namespace sqlite3
+  {
+    namespace detail
+    {
+      inline void append(std::ostringstream&)
+      {
+      }
+
+      template <typename Arg, typename... Args>
+      void append(std::ostringstream& out, const Arg& arg, const Args&... args)
+      {
+        out << arg;
+        append(out, args...);
+      }
+
+      //! compose the message from args, e.g. log(target, log_level::debug, handle, index, "binding ", value)
+      template <typename... Args>
+      void log(logger& target, log_level level, const void* statement, int index, const Args&... args)
+      {
+        std::ostringstream message;
+        append(message, args...);
+        target.log(log_record(level, message.str(), statement, index));
+      }
+
+      //! debug record concerning a statement and a parameter or column index (-1 for none)
+      template <typename... Args>
+      void log_debug(const prepared_statement_handle_t& handle, int index, const Args&... args)
+      {
+        log(*handle.log, log_level::debug, &handle, index, args...);
+      }
+    }  // namespace detail
+  }    // namespace sqlite3
+}  // namespace sqlpp
+
+#endif
@@ -32,6 +32,9 @@
 #else
 #include <sqlite3.h>
 #endif
+#include <memory>
+#include <sqlpp11/sqlite3/latency.h>
+#include <sqlpp11/sqlite3/logger.h>
 
 #ifdef SQLPP_DYNAMIC_LOADING
 #include <sqlpp11/sqlite3/dynamic_libsqlite3.h>
@@ -50,8 +53,12 @@ namespace sqlpp
       {
         sqlite3_stmt* sqlite_statement;
         bool debug;
+        bool read_only;  // the statement does not change the database (sqlite3_stmt_readonly), set when preparing
+        logger* log;     // owned by the connection's config
+        std::shared_ptr<statement_latency> latency;  // per statement text, if connection_config::latency_histograms
 
-        prepared_statement_handle_t(sqlite3_stmt* statement, bool debug_) : sqlite_statement(statement), debug(debug_)
+        prepared_statement_handle_t(sqlite3_stmt* statement, bool debug_, logger* log_)
+            : sqlite_statement(statement), debug(debug_), read_only(false), log(log_)
         {
         }
 
@@ -62,6 +69,9 @@ namespace sqlpp
           rhs.sqlite_statement = nullptr;
 
           debug = rhs.debug;
+          read_only = rhs.read_only;
+          log = rhs.log;
+          latency = std::move(rhs.latency);
         }
         prepared_statement_handle_t& operator=(const prepared_statement_handle_t&) = delete;
         prepared_statement_handle_t& operator=(prepared_statement_handle_t&& rhs)
@@ -72,6 +82,9 @@ namespace sqlpp
             rhs.sqlite_statement = nullptr;
           }
           debug = rhs.debug;
+          read_only = rhs.read_only;
+          log = rhs.log;
+          latency = std::move(rhs.latency);
 
           return *this;
         }
@@ -0,0 +1,413 @@
+/*
+ * Copyright (c) 2013 - 2015, Roland Bock
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ *   Redistributions of source code must retain the above copyright notice, this
+ *   list of conditions and the following disclaimer.
+ *
+ *   Redistributions in binary form must reproduce the above copyright notice, this
+ *   list of conditions and the following disclaimer in the documentation and/or
+ *   other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON
+ * ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "slab_allocator.h"
+#include <algorithm>
+#include <atomic>
+#include <cstdlib>
+#include <cstring>
+#include <mutex>
+#include <vector>
+
+namespace sqlpp
+{
+  namespace sqlite3
+  {
+    namespace detail
+    {
+      namespace
+      {
+        // Every block starts with a header holding its (rounded) size, which keeps the 8 byte alignment required
+        // by sqlite3 and answers xSize.
+        constexpr size_t header_size = 8;
+        constexpr size_t min_class_shift = 4;  // 16 bytes
+        constexpr size_t class_count = 10;     // up to 8 KiB
+        constexpr size_t slab_size = 256 * 1024;
+
+        constexpr size_t class_size(size_t size_class)
+        {
+          return size_t{1} << (size_class + min_class_shift);
+        }
+
+        size_t class_of(size_t size)
+        {
+          size_t size_class = 0;
+          while (size_class < class_count and class_size(size_class) < size)
+            ++size_class;
+          return size_class;
+        }
+
+        size_t round_up(size_t size)
+        {
+          const auto size_class = class_of(size);
+          return size_class < class_count ? class_size(size_class) : (size + 7) & ~size_t{7};
+        }
+
+        struct free_block
+        {
+          free_block* next;
+        };
+
+        struct shared_pool
+        {
+          std::mutex mutex;
+          free_block* blocks = nullptr;
+        };
+
+        struct thread_cache;
+
+        struct global_state
+        {
+          shared_pool pools[class_count];
+          size_t thread_cache_blocks = 64;
+
+          std::mutex slab_mutex;
+          std::vector<void*> slabs;
+          std::atomic<uint64_t> slab_bytes{0};
+
+          // statistics of running threads are collected on demand, those of finished threads are added up here
+          std::mutex registry_mutex;
+          std::vector<thread_cache*> caches;
+          allocator_stats retired;
+        };
+
+        // never destroyed: thread caches may be flushed after static destruction started
+        global_state& state()
+        {
+          static global_state* const instance = new global_state();
+          return *instance;
+        }
+
+        // counters are only written by the owning thread, atomics allow reading them from others
+        struct counter
+        {
+          std::atomic<int64_t> value{0};
+
+          void add(int64_t delta)
+          {
+            value.store(value.load(std::memory_order_relaxed) + delta, std::memory_order_relaxed);
+          }
+
+          int64_t get() const
+          {
+            return value.load(std::memory_order_relaxed);
+          }
+        };
+
+        // Set once the calling thread's cache is gone: the main thread destroys its thread_locals before static
+        // objects, so sqlite3 may still allocate and free afterwards. Trivially destructible, so it stays readable.
+        thread_local bool cache_destroyed = false;
+
+        struct thread_cache
+        {
+          free_block* blocks[class_count] = {};
+          size_t counts[class_count] = {};
+
+          counter allocations;
+          counter frees;
+          counter bytes_in_use;
+          counter large_allocations;
+          counter hits;
+
+          thread_cache()
+          {
+            auto& global = state();
+            std::lock_guard<std::mutex> lock(global.registry_mutex);
+            global.caches.push_back(this);
+          }
+
+          ~thread_cache()
+          {
+            cache_destroyed = true;
+            for (size_t size_class = 0; size_class < class_count; ++size_class)
+              release(size_class, counts[size_class]);
+
+            auto& global = state();
+            std::lock_guard<std::mutex> lock(global.registry_mutex);
+            add_to(global.retired);
+            global.caches.erase(std::find(global.caches.begin(), global.caches.end(), this));
+          }
+
+          void add_to(allocator_stats& stats) const
+          {
+            stats.allocations += static_cast<uint64_t>(allocations.get());
+            stats.frees += static_cast<uint64_t>(frees.get());
+            stats.bytes_in_use += bytes_in_use.get();
+            stats.large_allocations += static_cast<uint64_t>(large_allocations.get());
+            stats.thread_cache_hits += static_cast<uint64_t>(hits.get());
+          }
+
+          // hand count blocks of the given class over to the shared pool
+          void release(size_t size_class, size_t count)
+          {
+            if (count == 0)
+              return;
+            auto first = blocks[size_class];
+            auto last = first;
+            for (size_t i = 1; i < count; ++i)
+              last = last->next;
+            blocks[size_class] = last->next;
+            counts[size_class] -= count;
+
+            auto& pool = state().pools[size_class];
+            std::lock_guard<std::mutex> lock(pool.mutex);
+            last->next = pool.blocks;
+            pool.blocks = first;
+          }
+
+          // fetch up to count blocks from the shared pool, carving a new slab if it is empty
+          bool refill(size_t size_class, size_t count)
+          {
+            auto& global = state();
+            auto& pool = global.pools[size_class];
+            std::lock_guard<std::mutex> lock(pool.mutex);
+            if (not pool.blocks and not carve_slab(size_class, pool))
+              return false;
+            for (size_t i = 0; i < count and pool.blocks; ++i)
+            {
+              auto block = pool.blocks;
+              pool.blocks = block->next;
+              block->next = blocks[size_class];
+              blocks[size_class] = block;
+              ++counts[size_class];
+            }
+            return true;
+          }
+
+          static bool carve_slab(size_t size_class, shared_pool& pool)
+          {
+            auto& global = state();
+            auto slab = static_cast<char*>(std::malloc(slab_size));
+            if (not slab)
+              return false;
+            {
+              std::lock_guard<std::mutex> lock(global.slab_mutex);
+              global.slabs.push_back(slab);
+            }
+            global.slab_bytes += slab_size;
+
+            const auto block_size = header_size + class_size(size_class);
+            for (size_t offset = 0; offset + block_size <= slab_size; offset += block_size)
+            {
+              auto block = reinterpret_cast<free_block*>(slab + offset);
+              block->next = pool.blocks;
+              pool.blocks = block;
+            }
+            return true;
+          }
+        };
+
+        thread_cache& local_cache()
+        {
+          static thread_local thread_cache cache;
+          return cache;
+        }
+
+        uint64_t& header_of(void* p)
+        {
+          return *reinterpret_cast<uint64_t*>(static_cast<char*>(p) - header_size);
+        }
+
+        // statistics of allocations without a thread cache go straight to those of finished threads
+        void count_uncached(bool allocation, size_t size, size_t size_class)
+        {
+          auto& global = state();
+          std::lock_guard<std::mutex> lock(global.registry_mutex);
+          if (allocation)
+          {
+            ++global.retired.allocations;
+            global.retired.bytes_in_use += static_cast<int64_t>(size);
+            if (size_class == class_count)
+              ++global.retired.large_allocations;
+          }
+          else
+          {
+            ++global.retired.frees;
+            global.retired.bytes_in_use -= static_cast<int64_t>(size);
+          }
+        }
+
+        // used after the thread's cache was destroyed: every block goes through the shared pools
+        void* uncached_malloc(size_t size, size_t size_class)
+        {
+          char* block = nullptr;
+          if (size_class == class_count)
+          {
+            block = static_cast<char*>(std::malloc(header_size + size));
+            if (not block)
+              return nullptr;
+          }
+          else
+          {
+            auto& pool = state().pools[size_class];
+            std::lock_guard<std::mutex> lock(pool.mutex);
+            if (not pool.blocks and not thread_cache::carve_slab(size_class, pool))
+              return nullptr;
+            auto free = pool.blocks;
+            pool.blocks = free->next;
+            block = reinterpret_cast<char*>(free);
+          }
+          *reinterpret_cast<uint64_t*>(block) = size;
+          count_uncached(true, size, size_class);
+          return block + header_size;
+        }
+
+        void uncached_free(char* block, size_t size, size_t size_class)
+        {
+          count_uncached(false, size, size_class);
+          if (size_class == class_count)
+          {
+            std::free(block);
+            return;
+          }
+          auto& pool = state().pools[size_class];
+          std::lock_guard<std::mutex> lock(pool.mutex);
+          auto free = reinterpret_cast<free_block*>(block);
+          free->next = pool.blocks;
+          pool.blocks = free;
+        }
+
+        void* slab_malloc(int n)
+        {
+          const auto size = round_up(static_cast<size_t>(std::max(n, 1)));
+          const auto size_class = class_of(size);
+          if (cache_destroyed)
+            return uncached_malloc(size, size_class);
+          auto& cache = local_cache();
+
+          char* block = nullptr;
+          if (size_class == class_count)
+          {
+            block = static_cast<char*>(std::malloc(header_size + size));
+            if (not block)
+              return nullptr;
+            cache.large_allocations.add(1);
+          }
+          else
+          {
+            if (cache.blocks[size_class])
+              cache.hits.add(1);
+            else if (not cache.refill(size_class, std::max<size_t>(state().thread_cache_blocks / 2, 1)))
+              return nullptr;
+            auto free = cache.blocks[size_class];
+            cache.blocks[size_class] = free->next;
+            --cache.counts[size_class];
+            block = reinterpret_cast<char*>(free);
+          }
+
+          *reinterpret_cast<uint64_t*>(block) = size;
+          cache.allocations.add(1);
+          cache.bytes_in_use.add(static_cast<int64_t>(size));
+          return block + header_size;
+        }
+
+        void slab_free(void* p)
+        {
+          if (not p)
+            return;
+          const auto size = static_cast<size_t>(header_of(p));
+          const auto size_class = class_of(size);
+          auto block = static_cast<char*>(p) - header_size;
+          if (cache_destroyed)
+          {
+            uncached_free(block, size, size_class);
+            return;
+          }
+          auto& cache = local_cache();
+          cache.frees.add(1);
+          cache.bytes_in_use.add(-static_cast<int64_t>(size));
+
+          if (size_class == class_count)
+          {
+            std::free(block);
+            return;
+          }
+          auto free = reinterpret_cast<free_block*>(block);
+          free->next = cache.blocks[size_class];
+          cache.blocks[size_class] = free;
+          if (++cache.counts[size_class] > state().thread_cache_blocks)
+            cache.release(size_class, cache.counts[size_class] / 2);
+        }
+
+        int slab_size_of(void* p)
+        {
+          return p ? static_cast<int>(header_of(p)) : 0;
+        }
+
+        void* slab_realloc(void* p, int n)
+        {
+          if (not p)
+            return slab_malloc(n);
+          const auto size = static_cast<size_t>(header_of(p));
+          const auto new_size = round_up(static_cast<size_t>(std::max(n, 1)));
+          if (new_size == size)
+            return p;
+          auto result = slab_malloc(n);
+          if (result)
+          {
+            std::memcpy(result, p, std::min(size, new_size));
+            slab_free(p);
+          }
+          return result;
+        }
+
+        int slab_roundup(int n)
+        {
+          return static_cast<int>(round_up(static_cast<size_t>(std::max(n, 1))));
+        }
+
+        int slab_init(void*)
+        {
+          return SQLITE_OK;
+        }
+
+        void slab_shutdown(void*)
+        {
+          // slabs are kept, threads may still hold cached blocks
+        }
+      }  // namespace
+
+      const sqlite3_mem_methods* slab_allocator_methods(size_t thread_cache_blocks)
+      {
+        state().thread_cache_blocks = std::max<size_t>(thread_cache_blocks, 1);
+        static const sqlite3_mem_methods methods = {&slab_malloc,    &slab_free, &slab_realloc, &slab_size_of,
+                                                    &slab_roundup,   &slab_init, &slab_shutdown, nullptr};
+        return &methods;
+      }
+
+      allocator_stats slab_allocator_statistics()
+      {
+        auto& global = state();
+        std::lock_guard<std::mutex> lock(global.registry_mutex);
+        auto stats = global.retired;
+        for (const auto cache : global.caches)
+          cache->add_to(stats);
+        stats.slab_bytes = global.slab_bytes.load();
+        return stats;
+      }
+    }  // namespace detail
+  }    // namespace sqlite3
+}  // namespace sqlpp
@@ -0,0 +1,102 @@
+/*
+ * Copyright (c) 2013 - 2016, Roland Bock
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ *   Redistributions of source code must retain the above copyright notice, this
+ *   list of conditions and the following disclaimer.
+ *
+ *   Redistributions in binary form must reproduce the above copyright notice, this
+ *   list of conditions and the following disclaimer in the documentation and/or
+ *   other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON
+ * ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifdef SQLPP_USE_SQLCIPHER
+#include <sqlcipher/sqlite3.h>
+#else
+#include <sqlite3.h>
+#endif
+#include <sqlpp11/sqlite3/features.h>
+
+#ifdef SQLPP_DYNAMIC_LOADING
+#include <sqlpp11/sqlite3/dynamic_libsqlite3.h>
+#endif
+
+namespace sqlpp
+{
+  namespace sqlite3
+  {
+#ifdef SQLPP_DYNAMIC_LOADING
+    using namespace dynamic;
+#endif
+
+    namespace
+    {
+      // with dynamic loading, optional functions are nullptr if the library does not provide them
+      template <typename Function>
+      bool is_loaded(Function* function)
+      {
+        return function != nullptr;
+      }
+
+      bool compile_option(const char* name)
+      {
+        return is_loaded(sqlite3_compileoption_used) and sqlite3_compileoption_used(name);
+      }
+
+      library_features probe()
+      {
+#ifdef SQLPP_DYNAMIC_LOADING
+        init_sqlite("");
+#endif
+        library_features result;
+        const auto version = sqlite3_libversion_number();
+        result.version_number = version;
+        result.threadsafe = sqlite3_threadsafe();
+
+        result.upsert = version >= 3024000;
+        result.returning = version >= 3035000;
+        result.window_functions = version >= 3025000 and not compile_option("OMIT_WINDOWFUNC");
+        result.json = version >= 3038000 ? not compile_option("OMIT_JSON") : compile_option("ENABLE_JSON1");
+        result.math_functions = compile_option("ENABLE_MATH_FUNCTIONS");
+        result.fts5 = compile_option("ENABLE_FTS5");
+        result.rtree = compile_option("ENABLE_RTREE");
+
+#if SQLITE_VERSION_NUMBER >= 3020000
+        result.prepare_v3 = version >= 3020000 and is_loaded(sqlite3_prepare_v3);
+        result.carray = version >= 3020000 and is_loaded(sqlite3_bind_pointer) and is_loaded(sqlite3_value_pointer);
+#endif
+#if SQLITE_VERSION_NUMBER >= 3036000
+        result.serialize = version >= 3036000 and not compile_option("OMIT_DESERIALIZE") and
+                           is_loaded(sqlite3_serialize) and is_loaded(sqlite3_deserialize);
+#endif
+        result.snapshot = compile_option("ENABLE_SNAPSHOT");
+        result.preupdate_hook = compile_option("ENABLE_PREUPDATE_HOOK");
+        result.session = compile_option("ENABLE_SESSION");
+        result.unlock_notify = compile_option("ENABLE_UNLOCK_NOTIFY");
+        result.shared_cache = not compile_option("OMIT_SHARED_CACHE");
+        result.lookaside = not compile_option("OMIT_LOOKASIDE");
+        return result;
+      }
+    }  // namespace
+
+    const library_features& runtime_features()
+    {
+      static const library_features features = probe();
+      return features;
+    }
+  }  // namespace sqlite3
+}  // namespace sqlpp
@@ -0,0 +1,71 @@
+/*
+ * Copyright (c) 2013 - 2016, Roland Bock
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ *   Redistributions of source code must retain the above copyright notice, this
+ *   list of conditions and the following disclaimer.
+ *
+ *   Redistributions in binary form must reproduce the above copyright notice, this
+ *   list of conditions and the following disclaimer in the documentation and/or
+ *   other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON
+ * ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifdef SQLPP_USE_SQLCIPHER
+#include <sqlcipher/sqlite3.h>
+#else
+#include <sqlite3.h>
+#endif
+#include <sqlpp11/exception.h>
+#include <sqlpp11/sqlite3/initialize.h>
+#include <string>
+#include "detail/slab_allocator.h"
+
+#ifdef SQLPP_DYNAMIC_LOADING
+#include <sqlpp11/sqlite3/dynamic_libsqlite3.h>
+#endif
+
+namespace sqlpp
+{
+  namespace sqlite3
+  {
+#ifdef SQLPP_DYNAMIC_LOADING
+    using namespace dynamic;
+#endif
+
+    void initialize(const global_config& config)
+    {
+#ifdef SQLPP_DYNAMIC_LOADING
+      init_sqlite("");
+#endif
+      if (config.slab_allocator)
+      {
+        const auto rc = sqlite3_config(SQLITE_CONFIG_MALLOC, detail::slab_allocator_methods(config.thread_cache_blocks));
+        if (rc != SQLITE_OK)
+          throw sqlpp::exception("Sqlite3 error: Can't install allocator (initialize() must be called before sqlite3 is used): " +
+                                 std::string(sqlite3_errstr(rc)));
+      }
+      const auto rc = sqlite3_initialize();
+      if (rc != SQLITE_OK)
+        throw sqlpp::exception("Sqlite3 error: Can't initialize: " + std::string(sqlite3_errstr(rc)));
+    }
+
+    allocator_stats allocator_statistics()
+    {
+      return detail::slab_allocator_statistics();
+    }
+  }  // namespace sqlite3
+}  // namespace sqlpp
@@ -0,0 +1,221 @@
+/*
+ * Copyright (c) 2015 - 2016, Roland Bock
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ *  * Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ * LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE
+ * OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ * OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <sqlpp11/sqlite3/latency.h>
+#include <sstream>
+
+namespace sqlpp
+{
+  namespace sqlite3
+  {
+    namespace
+    {
+      // values below 2^sub_bucket_bits get a bucket each, every higher power of two is split into
+      // 2^sub_bucket_bits buckets
+      constexpr int sub_bucket_bits = 4;
+      constexpr uint64_t sub_buckets = uint64_t{1} << sub_bucket_bits;
+      constexpr int max_exponent = 40;
+      constexpr size_t bucket_count = sub_buckets * (max_exponent - sub_bucket_bits + 1);
+
+      int highest_bit(uint64_t value)
+      {
+        int bit = 0;
+        for (int shift = 32; shift > 0; shift /= 2)
+        {
+          if (value >> shift)
+          {
+            value >>= shift;
+            bit += shift;
+          }
+        }
+        return bit;
+      }
+
+      size_t bucket_of(uint64_t value)
+      {
+        if (value < sub_buckets)
+          return static_cast<size_t>(value);
+        const int exponent = highest_bit(value);
+        if (exponent >= max_exponent)
+          return bucket_count - 1;
+        const int shift = exponent - sub_bucket_bits;
+        return static_cast<size_t>(sub_buckets * (shift + 1) + ((value >> shift) & (sub_buckets - 1)));
+      }
+
+      uint64_t lowest_value_of(size_t bucket)
+      {
+        if (bucket < sub_buckets)
+          return bucket;
+        const auto shift = bucket / sub_buckets - 1;
+        return (sub_buckets + bucket % sub_buckets) << shift;
+      }
+
+      uint64_t highest_value_of(size_t bucket)
+      {
+        if (bucket < sub_buckets)
+          return bucket;
+        const auto shift = bucket / sub_buckets - 1;
+        return lowest_value_of(bucket) + (uint64_t{1} << shift) - 1;
+      }
+
+      void append_json_string(std::ostream& os, const std::string& text)
+      {
+        os << '"';
+        for (const char c : text)
+        {
+          switch (c)
+          {
+            case '"':
+              os << "\\\"";
+              break;
+            case '\\':
+              os << "\\\\";
+              break;
+            case '\n':
+              os << "\\n";
+              break;
+            case '\r':
+              os << "\\r";
+              break;
+            case '\t':
+              os << "\\t";
+              break;
+            default:
+              if (static_cast<unsigned char>(c) < 0x20)
+              {
+                char escaped[8];
+                std::snprintf(escaped, sizeof(escaped), "\\u%04x", static_cast<unsigned>(c));
+                os << escaped;
+              }
+              else
+                os << c;
+          }
+        }
+        os << '"';
+      }
+    }  // namespace
+
+    void latency_histogram::record(uint64_t nanoseconds)
+    {
+      if (_buckets.empty())
+        _buckets.resize(bucket_count);
+      ++_buckets[bucket_of(nanoseconds)];
+      _min = _count ? std::min(_min, nanoseconds) : nanoseconds;
+      _max = std::max(_max, nanoseconds);
+      _sum += nanoseconds;
+      ++_count;
+    }
+
+    void latency_histogram::merge(const latency_histogram& other)
+    {
+      if (other._count == 0)
+        return;
+      if (_buckets.empty())
+        _buckets.resize(bucket_count);
+      for (size_t i = 0; i < bucket_count; ++i)
+        _buckets[i] += other._buckets[i];
+      _min = _count ? std::min(_min, other._min) : other._min;
+      _max = std::max(_max, other._max);
+      _sum += other._sum;
+      _count += other._count;
+    }
+
+    uint64_t latency_histogram::percentile(double percent) const
+    {
+      if (_count == 0)
+        return 0;
+      const auto bounded = std::max(0.0, std::min(percent, 100.0));
+      const auto rank = static_cast<uint64_t>(std::ceil(bounded * static_cast<double>(_count) / 100.0));
+      if (rank == 0)
+        return _min;
+      uint64_t seen = 0;
+      for (size_t i = 0; i < bucket_count; ++i)
+      {
+        seen += _buckets[i];
+        if (seen >= rank)
+          return i + 1 == bucket_count ? _max : std::max(_min, std::min(highest_value_of(i), _max));
+      }
+      return _max;
+    }
+
+    std::string latency_histogram::to_json() const
+    {
+      std::ostringstream os;
+      os << "{\"count\":" << _count << ",\"min\":" << _min << ",\"max\":" << _max << ",\"mean\":" << mean()
+         << ",\"p50\":" << percentile(50) << ",\"p90\":" << percentile(90) << ",\"p99\":" << percentile(99)
+         << ",\"p999\":" << percentile(99.9) << ",\"buckets\":[";
+      bool first = true;
+      for (size_t i = 0; i < _buckets.size(); ++i)
+      {
+        if (_buckets[i] == 0)
+          continue;
+        os << (first ? "" : ",") << '[' << lowest_value_of(i) << ',' << _buckets[i] << ']';
+        first = false;
+      }
+      os << "]}";
+      return os.str();
+    }
+
+    void statement_latency::merge(const statement_latency& other)
+    {
+      prepare.merge(other.prepare);
+      bind.merge(other.bind);
+      step.merge(other.step);
+      decode.merge(other.decode);
+      reset.merge(other.reset);
+    }
+
+    std::string statement_latency::to_json() const
+    {
+      return "{\"prepare\":" + prepare.to_json() + ",\"bind\":" + bind.to_json() + ",\"step\":" + step.to_json() +
+             ",\"decode\":" + decode.to_json() + ",\"reset\":" + reset.to_json() + "}";
+    }
+
+    void merge(latency_report& into, const latency_report& from)
+    {
+      for (const auto& entry : from)
+        into[entry.first].merge(entry.second);
+    }
+
+    std::string to_json(const latency_report& report)
+    {
+      std::ostringstream os;
+      os << '{';
+      bool first = true;
+      for (const auto& entry : report)
+      {
+        os << (first ? "" : ",");
+        append_json_string(os, entry.first);
+        os << ':' << entry.second.to_json();
+        first = false;
+      }
+      os << '}';
+      return os.str();
+    }
+  }  // namespace sqlite3
+}  // namespace sqlpp
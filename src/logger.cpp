@@ -0,0 +1,173 @@
+/*
+ * Copyright (c) 2015 - 2016, Roland Bock
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ *  * Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ * LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE
+ * OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ * OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <condition_variable>
+#include <iostream>
+#include <mutex>
+#include <sqlpp11/sqlite3/logger.h>
+#include <sstream>
+#include <thread>
+#include <vector>
+
+namespace sqlpp
+{
+  namespace sqlite3
+  {
+    struct async_logger::state
+    {
+      std::ostream& out;
+
+      std::mutex mutex;
+      std::condition_variable pending;
+      std::condition_variable written;
+      std::vector<log_record> records;
+      size_t logged = 0;   // records handed to log() so far
+      size_t flushed = 0;  // records written so far
+      bool stopping = false;
+      std::thread thread;
+
+      state(std::ostream& out_) : out(out_)
+      {
+      }
+
+      void run()
+      {
+        std::vector<log_record> batch;
+        std::string text;
+        std::unique_lock<std::mutex> lock(mutex);
+        while (true)
+        {
+          pending.wait(lock, [this] { return stopping or not records.empty(); });
+          if (records.empty())
+          {
+            return;
+          }
+          batch.swap(records);
+
+          lock.unlock();
+          text.clear();
+          for (const auto& record : batch)
+          {
+            text += format(record);
+            text += '\n';
+          }
+          out.write(text.data(), static_cast<std::streamsize>(text.size()));
+          out.flush();
+          const auto count = batch.size();
+          batch.clear();
+          lock.lock();
+
+          flushed += count;
+          written.notify_all();
+        }
+      }
+    };
+
+    async_logger::async_logger(std::ostream& out) : _state(new state(out))
+    {
+      _state->thread = std::thread([this] { _state->run(); });
+    }
+
+    async_logger::~async_logger()
+    {
+      {
+        std::lock_guard<std::mutex> lock(_state->mutex);
+        _state->stopping = true;
+      }
+      _state->pending.notify_one();
+      _state->thread.join();
+    }
+
+    void async_logger::log(const log_record& record)
+    {
+      bool was_empty = false;
+      {
+        std::lock_guard<std::mutex> lock(_state->mutex);
+        was_empty = _state->records.empty();
+        _state->records.push_back(record);
+        ++_state->logged;
+      }
+      if (was_empty)
+      {
+        _state->pending.notify_one();
+      }
+    }
+
+    void async_logger::flush()
+    {
+      std::unique_lock<std::mutex> lock(_state->mutex);
+      const auto target = _state->logged;
+      _state->pending.notify_one();
+      _state->written.wait(lock, [this, target] { return _state->flushed >= target; });
+    }
+
+    std::string format(const log_record& record)
+    {
+      std::ostringstream out;
+      switch (record.level)
+      {
+        case log_level::debug:
+          out << "Sqlite3 debug: ";
+          break;
+        case log_level::warning:
+          out << "Sqlite3 warning: ";
+          break;
+        case log_level::error:
+          out << "Sqlite3 error: ";
+          break;
+      }
+      out << record.message;
+
+      const bool has_fields =
+          record.statement != nullptr or record.index >= 0 or record.duration >= std::chrono::microseconds(0);
+      if (has_fields)
+      {
+        const char* separator = " [";
+        if (record.statement)
+        {
+          out << separator << "statement=" << record.statement;
+          separator = " ";
+        }
+        if (record.index >= 0)
+        {
+          out << separator << "index=" << record.index;
+          separator = " ";
+        }
+        if (record.duration >= std::chrono::microseconds(0))
+        {
+          out << separator << "duration=" << record.duration.count() << "us";
+        }
+        out << "]";
+      }
+      return out.str();
+    }
+
+    std::shared_ptr<logger> default_logger()
+    {
+      static const std::shared_ptr<logger> instance = std::make_shared<async_logger>(std::cerr);
+      return instance;
+    }
+  }  // namespace sqlite3
+}  // namespace sqlpp
@@ -0,0 +1,158 @@
+/*
+ * Copyright (c) 2015 - 2016, Roland Bock
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ *  * Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ * LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE
+ * OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ * OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifdef SQLPP_USE_SQLCIPHER
+#include <sqlcipher/sqlite3.h>
+#else
+#include <sqlite3.h>
+#endif
+#include <sqlpp11/exception.h>
+#include <sqlpp11/sqlite3/parallel_select.h>
+#include <sqlpp11/sqlite3/snapshot.h>
+
+#ifdef SQLPP_DYNAMIC_LOADING
+#include <sqlpp11/sqlite3/dynamic_libsqlite3.h>
+#endif
+
+namespace sqlpp
+{
+  namespace sqlite3
+  {
+#ifdef SQLPP_DYNAMIC_LOADING
+    using namespace dynamic;
+#endif
+
+    namespace
+    {
+      std::string quoted_identifier(const std::string& name)
+      {
+        std::string result = "\"";
+        for (const char c : name)
+        {
+          if (c == '"')
+            result.push_back(c);
+          result.push_back(c);
+        }
+        return result + "\"";
+      }
+    }  // namespace
+
+    std::vector<rowid_range> split_rowid_range(connection& db, const std::string& table, size_t count)
+    {
+      const auto statement = "SELECT min(rowid), max(rowid) FROM " + quoted_identifier(table);
+      sqlite3_stmt* stmt = nullptr;
+      auto rc = sqlite3_prepare_v2(db.native_handle(), statement.c_str(), static_cast<int>(statement.size()), &stmt,
+                                   nullptr);
+      if (rc != SQLITE_OK)
+      {
+        throw sqlpp::exception("Sqlite3 error: Could not determine rowid range of " + table + ": " +
+                               std::string(sqlite3_errmsg(db.native_handle())));
+      }
+      rc = sqlite3_step(stmt);
+      if (rc != SQLITE_ROW)
+      {
+        const std::string msg = sqlite3_errmsg(db.native_handle());
+        sqlite3_finalize(stmt);
+        throw sqlpp::exception("Sqlite3 error: Could not determine rowid range of " + table + ": " + msg);
+      }
+      const bool empty = sqlite3_column_type(stmt, 0) == SQLITE_NULL;
+      const int64_t min = sqlite3_column_int64(stmt, 0);
+      const int64_t max = sqlite3_column_int64(stmt, 1);
+      sqlite3_finalize(stmt);
+
+      std::vector<rowid_range> ranges;
+      if (empty)
+        return ranges;
+
+      // unsigned, as the span of all possible rowids does not fit into int64_t
+      const auto span = static_cast<uint64_t>(max) - static_cast<uint64_t>(min);
+      const auto parts = static_cast<uint64_t>(count ? count : 1);
+      const auto width = span / parts + 1;
+      for (uint64_t offset = 0; offset <= span; offset += width)
+      {
+        const auto first = static_cast<int64_t>(static_cast<uint64_t>(min) + offset);
+        const auto last = span - offset < width ? max : static_cast<int64_t>(static_cast<uint64_t>(first) + width - 1);
+        ranges.push_back({first, last});
+        if (last == max)
+          break;
+      }
+      return ranges;
+    }
+
+    namespace detail
+    {
+      std::vector<std::unique_ptr<connection>> open_consistent_readers(const connection_config& config,
+                                                                       size_t count,
+                                                                       std::chrono::milliseconds lock_timeout)
+      {
+        auto reader_config = config;
+        reader_config.flags &= ~SQLITE_OPEN_CREATE;
+
+        std::vector<std::unique_ptr<connection>> readers;
+        if (runtime_features().snapshot)
+        {
+          // pin all readers to the snapshot of the first one, writers are not affected
+          try
+          {
+            readers.emplace_back(new connection(reader_config));
+            const snapshot state(*readers.front());
+            for (size_t i = 1; i < count; ++i)
+            {
+              readers.emplace_back(new connection(reader_config));
+              state.open(*readers.back());
+            }
+            return readers;
+          }
+          catch (const sqlpp::exception&)
+          {
+            // e.g. not in WAL mode or snapshots not compiled in
+            readers.clear();
+          }
+        }
+
+        std::unique_ptr<connection> barrier;
+        if (not(config.flags & SQLITE_OPEN_READONLY))
+        {
+          barrier.reset(new connection(reader_config));
+          barrier->execute("PRAGMA busy_timeout = " + std::to_string(lock_timeout.count()));
+          barrier->start_transaction(transaction_mode::immediate);
+        }
+
+        for (size_t i = 0; i < count; ++i)
+        {
+          readers.emplace_back(new connection(reader_config));
+          auto& reader = *readers.back();
+          reader.start_transaction(transaction_mode::deferred);
+          // the read transaction (and thus the snapshot in WAL mode) starts with the first read
+          reader.execute("SELECT count(*) FROM sqlite_master");
+        }
+
+        if (barrier)
+          barrier->rollback_transaction(false);
+        return readers;
+      }
+    }  // namespace detail
+  }    // namespace sqlite3
+}  // namespace sqlpp
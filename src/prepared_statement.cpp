@@ -24,12 +24,15 @@
  * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
  */
 
+#include "detail/carray.h"
+#include "detail/latency_timer.h"
+#include "detail/log.h"
 #include "detail/prepared_statement_handle.h"
 #include <ciso646>
 #include <cmath>
 #include <date/date.h>
-#include <iostream>
 #include <sqlpp11/exception.h>
+#include <sqlpp11/sqlite3/features.h>
 #include <sqlpp11/sqlite3/prepared_statement.h>
 #include <sstream>
 #include <string>
@@ -81,27 +84,58 @@ namespace sqlpp
                                    " bind returned unexpected value: " + std::to_string(result));
         }
       }
+
+      void bind_carray(detail::prepared_statement_handle_t& handle,
+                       size_t index,
+                       const void* value,
+                       size_t size,
+                       const char* pointer_type)
+      {
+        if (handle.debug)
+          detail::log_debug(handle, index, "binding carray parameter size of ", size);
+
+        detail::phase_timer timer(handle.latency.get(), &statement_latency::bind);
+#if SQLITE_VERSION_NUMBER >= 3020000
+        if (not runtime_features().carray)
+          throw sqlpp::exception("Sqlite3 error: carray parameters require sqlite3 3.20.0 or later");
+        const auto result = sqlite3_bind_pointer(handle.sqlite_statement, static_cast<int>(index + 1),
+                                                 const_cast<void*>(value), pointer_type, nullptr);
+        check_bind_result(result, "carray");
+#else
+        (void)value;
+        (void)pointer_type;
+        throw sqlpp::exception("Sqlite3 error: carray parameters require sqlite3 3.20.0 or later");
+#endif
+      }
     }  // namespace
 
     prepared_statement_t::prepared_statement_t(std::shared_ptr<detail::prepared_statement_handle_t>&& handle)
         : _handle(std::move(handle))
     {
       if (_handle and _handle->debug)
-        std::cerr << "Sqlite3 debug: Constructing prepared_statement, using handle at " << _handle.get() << std::endl;
+        detail::log_debug(*_handle, -1, "Constructing prepared_statement");
+    }
+
+    bool prepared_statement_t::is_read_only() const
+    {
+      return _handle and _handle->read_only;
     }
 
     void prepared_statement_t::_reset()
     {
       if (_handle->debug)
-        std::cerr << "Sqlite3 debug: resetting prepared statement" << std::endl;
+        detail::log_debug(*_handle, -1, "resetting prepared statement");
+      detail::phase_timer timer(_handle->latency.get(), &statement_latency::reset);
       sqlite3_reset(_handle->sqlite_statement);
     }
 
     void prepared_statement_t::_bind_boolean_parameter(size_t index, const signed char* value, bool is_null)
     {
       if (_handle->debug)
-        std::cerr << "Sqlite3 debug: binding boolean parameter " << (*value ? "true" : "false")
-                  << " at index: " << index << ", being " << (is_null ? "" : "not ") << "null" << std::endl;
+        detail::log_debug(*_handle, index, "binding boolean parameter ", (*value ? "true" : "false"), ", being ",
+                          (is_null ? "" : "not "), "null");
+
+      detail::phase_timer timer(_handle->latency.get(), &statement_latency::bind);
 
       int result;
       if (not is_null)
@@ -114,8 +148,10 @@ namespace sqlpp
     void prepared_statement_t::_bind_floating_point_parameter(size_t index, const double* value, bool is_null)
     {
       if (_handle->debug)
-        std::cerr << "Sqlite3 debug: binding floating_point parameter " << *value << " at index: " << index
-                  << ", being " << (is_null ? "" : "not ") << "null" << std::endl;
+        detail::log_debug(*_handle, index, "binding floating_point parameter ", *value, ", being ",
+                          (is_null ? "" : "not "), "null");
+
+      detail::phase_timer timer(_handle->latency.get(), &statement_latency::bind);
 
       int result;
       if (not is_null)
@@ -141,8 +177,10 @@ namespace sqlpp
     void prepared_statement_t::_bind_integral_parameter(size_t index, const int64_t* value, bool is_null)
     {
       if (_handle->debug)
-        std::cerr << "Sqlite3 debug: binding integral parameter " << *value << " at index: " << index << ", being "
-                  << (is_null ? "" : "not ") << "null" << std::endl;
+        detail::log_debug(*_handle, index, "binding integral parameter ", *value, ", being ", (is_null ? "" : "not "),
+                          "null");
+
+      detail::phase_timer timer(_handle->latency.get(), &statement_latency::bind);
 
       int result;
       if (not is_null)
@@ -155,8 +193,10 @@ namespace sqlpp
     void prepared_statement_t::_bind_unsigned_integral_parameter(size_t index, const uint64_t* value, bool is_null)
     {
       if (_handle->debug)
-        std::cerr << "Sqlite3 debug: binding unsigned integral parameter " << *value << " at index: " << index
-                  << ", being " << (is_null ? "" : "not ") << "null" << std::endl;
+        detail::log_debug(*_handle, index, "binding unsigned integral parameter ", *value, ", being ",
+                          (is_null ? "" : "not "), "null");
+
+      detail::phase_timer timer(_handle->latency.get(), &statement_latency::bind);
 
       int result;
       if (not is_null)
@@ -170,8 +210,10 @@ namespace sqlpp
     void prepared_statement_t::_bind_text_parameter(size_t index, const std::string* value, bool is_null)
     {
       if (_handle->debug)
-        std::cerr << "Sqlite3 debug: binding text parameter " << *value << " at index: " << index << ", being "
-                  << (is_null ? "" : "not ") << "null" << std::endl;
+        detail::log_debug(*_handle, index, "binding text parameter ", *value, ", being ", (is_null ? "" : "not "),
+                          "null");
+
+      detail::phase_timer timer(_handle->latency.get(), &statement_latency::bind);
 
       int result;
       if (not is_null)
@@ -185,8 +227,9 @@ namespace sqlpp
     void prepared_statement_t::_bind_date_parameter(size_t index, const ::sqlpp::chrono::day_point* value, bool is_null)
     {
       if (_handle->debug)
-        std::cerr << "Sqlite3 debug: binding date parameter "
-                  << " at index: " << index << ", being " << (is_null ? "" : "not ") << "null" << std::endl;
+        detail::log_debug(*_handle, index, "binding date parameter, being ", (is_null ? "" : "not "), "null");
+
+      detail::phase_timer timer(_handle->latency.get(), &statement_latency::bind);
 
       int result;
       if (not is_null)
@@ -208,8 +251,9 @@ namespace sqlpp
                                                          bool is_null)
     {
       if (_handle->debug)
-        std::cerr << "Sqlite3 debug: binding date_time parameter "
-                  << " at index: " << index << ", being " << (is_null ? "" : "not ") << "null" << std::endl;
+        detail::log_debug(*_handle, index, "binding date_time parameter, being ", (is_null ? "" : "not "), "null");
+
+      detail::phase_timer timer(_handle->latency.get(), &statement_latency::bind);
 
       int result;
       if (not is_null)
@@ -230,8 +274,10 @@ namespace sqlpp
     void prepared_statement_t::_bind_blob_parameter(size_t index, const std::vector<uint8_t>* value, bool is_null)
     {
       if (_handle->debug)
-        std::cerr << "Sqlite3 debug: binding vector parameter size of " << value->size() << " at index: " << index
-                  << ", being " << (is_null ? "" : "not ") << "null" << std::endl;
+        detail::log_debug(*_handle, index, "binding vector parameter size of ", value->size(), ", being ",
+                          (is_null ? "" : "not "), "null");
+
+      detail::phase_timer timer(_handle->latency.get(), &statement_latency::bind);
 
       int result;
       if (not is_null)
@@ -241,5 +287,20 @@ namespace sqlpp
         result = sqlite3_bind_null(_handle->sqlite_statement, static_cast<int>(index + 1));
       check_bind_result(result, "blob");
     }
+
+    void prepared_statement_t::_bind_carray_parameter(size_t index, const std::vector<int64_t>* value)
+    {
+      bind_carray(*_handle, index, value, value->size(), detail::carray_int64_pointer_type);
+    }
+
+    void prepared_statement_t::_bind_carray_parameter(size_t index, const std::vector<double>* value)
+    {
+      bind_carray(*_handle, index, value, value->size(), detail::carray_double_pointer_type);
+    }
+
+    void prepared_statement_t::_bind_carray_parameter(size_t index, const std::vector<std::string>* value)
+    {
+      bind_carray(*_handle, index, value, value->size(), detail::carray_text_pointer_type);
+    }
   }  // namespace sqlite3
 }  // namespace sqlpp
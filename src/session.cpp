@@ -0,0 +1,244 @@
+/*
+ * Copyright (c) 2013 - 2016, Roland Bock
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ *   Redistributions of source code must retain the above copyright notice, this
+ *   list of conditions and the following disclaimer.
+ *
+ *   Redistributions in binary form must reproduce the above copyright notice, this
+ *   list of conditions and the following disclaimer in the documentation and/or
+ *   other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON
+ * ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifdef SQLPP_USE_SQLCIPHER
+#include <sqlcipher/sqlite3.h>
+#else
+#include <sqlite3.h>
+#endif
+#include <exception>
+#include <sqlpp11/exception.h>
+#include <sqlpp11/sqlite3/connection.h>
+#include <sqlpp11/sqlite3/session.h>
+
+#ifdef SQLPP_DYNAMIC_LOADING
+#include <sqlpp11/sqlite3/dynamic_libsqlite3.h>
+#endif
+
+namespace sqlpp
+{
+  namespace sqlite3
+  {
+#ifdef SQLPP_DYNAMIC_LOADING
+    using namespace dynamic;
+#endif
+
+    namespace
+    {
+      // with dynamic loading, optional functions are nullptr if the library does not provide them
+      template <typename Function>
+      bool is_loaded(Function* function)
+      {
+        return function != nullptr;
+      }
+
+      // the session functions are only declared (and linkable) with SQLITE_ENABLE_SESSION
+      void check_session_support()
+      {
+#ifdef SQLITE_ENABLE_SESSION
+        if (runtime_features().session and is_loaded(sqlite3session_create) and is_loaded(sqlite3changeset_apply))
+        {
+          return;
+        }
+#endif
+        throw sqlpp::exception("Sqlite3 error: session extension not supported by sqlite3 " +
+                               std::to_string(runtime_features().version_number) +
+                               " (requires SQLITE_ENABLE_SESSION)");
+      }
+
+#ifdef SQLITE_ENABLE_SESSION
+      conflict_type to_conflict_type(int conflict)
+      {
+        switch (conflict)
+        {
+          case SQLITE_CHANGESET_DATA:
+            return conflict_type::data;
+          case SQLITE_CHANGESET_NOTFOUND:
+            return conflict_type::not_found;
+          case SQLITE_CHANGESET_CONFLICT:
+            return conflict_type::conflict;
+          case SQLITE_CHANGESET_FOREIGN_KEY:
+            return conflict_type::foreign_key;
+          default:
+            return conflict_type::constraint;
+        }
+      }
+
+      struct apply_context
+      {
+        const conflict_handler& on_conflict;
+        std::exception_ptr error;
+      };
+
+      int on_changeset_conflict(void* context, int conflict, sqlite3_changeset_iter* iterator)
+      {
+        auto& apply = *static_cast<apply_context*>(context);
+        if (not apply.on_conflict)
+          return SQLITE_CHANGESET_ABORT;
+
+        const char* table = nullptr;
+        int columns = 0;
+        int operation = 0;
+        sqlite3changeset_op(iterator, &table, &columns, &operation, nullptr);
+        try
+        {
+          switch (apply.on_conflict(to_conflict_type(conflict), table ? table : ""))
+          {
+            case conflict_action::omit:
+              return SQLITE_CHANGESET_OMIT;
+            case conflict_action::replace:
+              return SQLITE_CHANGESET_REPLACE;
+            case conflict_action::abort:
+              return SQLITE_CHANGESET_ABORT;
+          }
+        }
+        catch (...)
+        {
+          apply.error = std::current_exception();
+        }
+        return SQLITE_CHANGESET_ABORT;
+      }
+#endif
+    }  // namespace
+
+    changeset::changeset(std::vector<uint8_t> data) : _data(std::move(data))
+    {
+    }
+
+    changeset::changeset(const uint8_t* data, size_t size) : _data(data, data + size)
+    {
+    }
+
+    change_capture::change_capture(connection& db, const std::vector<std::string>& tables, const std::string& schema)
+    {
+      check_session_support();
+#ifdef SQLITE_ENABLE_SESSION
+      auto rc = sqlite3session_create(db.native_handle(), schema.c_str(), &_session);
+      if (rc != SQLITE_OK)
+      {
+        throw sqlpp::exception("Sqlite3 error: Could not create session: " + std::string(sqlite3_errstr(rc)));
+      }
+      if (tables.empty())
+      {
+        rc = sqlite3session_attach(_session, nullptr);
+      }
+      for (const auto& table : tables)
+      {
+        rc = sqlite3session_attach(_session, table.c_str());
+        if (rc != SQLITE_OK)
+          break;
+      }
+      if (rc != SQLITE_OK)
+      {
+        sqlite3session_delete(_session);
+        _session = nullptr;
+        throw sqlpp::exception("Sqlite3 error: Could not attach tables to session: " + std::string(sqlite3_errstr(rc)));
+      }
+#else
+      (void)db;
+      (void)tables;
+      (void)schema;
+#endif
+    }
+
+    change_capture::change_capture(change_capture&& rhs) noexcept : _session(rhs._session)
+    {
+      rhs._session = nullptr;
+    }
+
+    change_capture& change_capture::operator=(change_capture&& rhs) noexcept
+    {
+      std::swap(_session, rhs._session);
+      return *this;
+    }
+
+    change_capture::~change_capture()
+    {
+#ifdef SQLITE_ENABLE_SESSION
+      if (_session)
+        sqlite3session_delete(_session);
+#endif
+    }
+
+    changeset change_capture::changes() const
+    {
+      if (not _session)
+      {
+        throw sqlpp::exception("Sqlite3 error: Cannot read changes of a moved-from capture");
+      }
+#ifdef SQLITE_ENABLE_SESSION
+      int size = 0;
+      void* data = nullptr;
+      const auto rc = sqlite3session_changeset(_session, &size, &data);
+      if (rc != SQLITE_OK)
+      {
+        throw sqlpp::exception("Sqlite3 error: Could not create changeset: " + std::string(sqlite3_errstr(rc)));
+      }
+      changeset result(static_cast<const uint8_t*>(data), static_cast<size_t>(size));
+      sqlite3_free(data);
+      return result;
+#else
+      return {};
+#endif
+    }
+
+    bool change_capture::empty() const
+    {
+#ifdef SQLITE_ENABLE_SESSION
+      return not _session or sqlite3session_isempty(_session);
+#else
+      return true;
+#endif
+    }
+
+    // connection's session functions live here with the rest of the session extension support
+    change_capture connection::capture_changes(const std::vector<std::string>& tables)
+    {
+      return change_capture(*this, tables);
+    }
+
+    void connection::apply_changes(const changeset& changes, const conflict_handler& on_conflict)
+    {
+      check_session_support();
+#ifdef SQLITE_ENABLE_SESSION
+      apply_context context{on_conflict, nullptr};
+      const auto rc = sqlite3changeset_apply(native_handle(), static_cast<int>(changes.size()),
+                                             const_cast<uint8_t*>(changes.data()), nullptr, on_changeset_conflict,
+                                             &context);
+      if (context.error)
+        std::rethrow_exception(context.error);
+      if (rc != SQLITE_OK)
+      {
+        // SQLITE_ABORT if a conflict aborted the apply, in which case sqlite3_errmsg has no details
+        throw sqlpp::exception("Sqlite3 error: Could not apply changeset: " + std::string(sqlite3_errstr(rc)));
+      }
+#else
+      (void)changes;
+      (void)on_conflict;
+#endif
+    }
+  }  // namespace sqlite3
+}  // namespace sqlpp
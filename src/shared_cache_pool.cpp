@@ -0,0 +1,247 @@
+/*
+ * Copyright (c) 2015 - 2016, Roland Bock
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ *  * Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ * LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE
+ * OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ * OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifdef SQLPP_USE_SQLCIPHER
+#include <sqlcipher/sqlite3.h>
+#else
+#include <sqlite3.h>
+#endif
+#include <condition_variable>
+#include <mutex>
+#include <unordered_map>
+#include <sqlpp11/exception.h>
+#include <sqlpp11/sqlite3/shared_cache_pool.h>
+#include <vector>
+
+namespace sqlpp
+{
+  namespace sqlite3
+  {
+    pooled_connection::pooled_connection(shared_cache_pool& pool, std::unique_ptr<connection> db, bool writer)
+        : _pool(&pool), _db(std::move(db)), _writer(writer)
+    {
+    }
+
+    pooled_connection::pooled_connection(pooled_connection&& rhs) noexcept
+        : _pool(rhs._pool), _db(std::move(rhs._db)), _writer(rhs._writer)
+    {
+    }
+
+    pooled_connection& pooled_connection::operator=(pooled_connection&& rhs) noexcept
+    {
+      if (this != &rhs)
+      {
+        release();
+        _pool = rhs._pool;
+        _db = std::move(rhs._db);
+        _writer = rhs._writer;
+      }
+      return *this;
+    }
+
+    pooled_connection::~pooled_connection()
+    {
+      release();
+    }
+
+    void pooled_connection::release()
+    {
+      if (_db)
+      {
+        _pool->give_back(std::move(_db), _writer);
+      }
+    }
+
+    namespace
+    {
+      constexpr size_t max_cached_classifications = 1000;
+    }
+
+    struct shared_cache_pool::state
+    {
+      const connection_config reader_config;
+      const size_t max_readers;
+
+      mutable std::mutex mutex;
+      std::condition_variable available;
+      // the writer keeps an in-memory database alive, so it is never closed before the pool
+      std::unique_ptr<connection> writer;
+      const connection* serializing_connection;  // the writer, wherever it is borrowed to
+      std::vector<std::unique_ptr<connection>> idle_readers;
+      size_t open_readers = 0;
+
+      std::mutex read_only_mutex;
+      // texts include literal values, so the cache is bounded; further statements are classified each time
+      std::unordered_map<std::string, bool> read_only_statements;
+
+      state(connection_config config, size_t max_readers_)
+          : reader_config(config), max_readers(max_readers_ ? max_readers_ : 1)
+      {
+        config.flags |= SQLITE_OPEN_SHAREDCACHE | SQLITE_OPEN_URI;
+        if (not(config.flags & SQLITE_OPEN_READONLY))
+        {
+          config.flags |= SQLITE_OPEN_READWRITE;
+        }
+        writer.reset(new connection(std::move(config)));
+        serializing_connection = writer.get();
+        idle_readers.reserve(max_readers);  // handing back readers must not throw
+      }
+
+      std::unique_ptr<connection> open_reader() const
+      {
+        auto config = reader_config;
+        config.flags |= SQLITE_OPEN_SHAREDCACHE | SQLITE_OPEN_URI;
+        config.flags &= ~SQLITE_OPEN_CREATE;
+        std::unique_ptr<connection> db(new connection(std::move(config)));
+        db->set_default_isolation_level(isolation_level::read_uncommitted);
+        // SQLITE_OPEN_READONLY does not stop writes to a cache shared with a writer, query_only does
+        db->execute("PRAGMA query_only = true");
+        return db;
+      }
+    };
+
+    shared_cache_pool::shared_cache_pool(const std::string& name, size_t max_readers, bool debug)
+        : shared_cache_pool(connection_config("file:" + name + "?mode=memory&cache=shared",
+                                              SQLITE_OPEN_READWRITE | SQLITE_OPEN_CREATE, "", debug),
+                            max_readers)
+    {
+    }
+
+    shared_cache_pool::shared_cache_pool(connection_config config, size_t max_readers)
+        : _state(new state(std::move(config), max_readers))
+    {
+    }
+
+    shared_cache_pool::~shared_cache_pool() = default;
+
+    pooled_connection shared_cache_pool::writer()
+    {
+      std::unique_lock<std::mutex> lock(_state->mutex);
+      _state->available.wait(lock, [this]() { return _state->writer != nullptr; });
+      return {*this, std::move(_state->writer), true};
+    }
+
+    pooled_connection shared_cache_pool::reader()
+    {
+      return {*this, take_reader(true), false};
+    }
+
+    // if all readers are in use, wait for one or return nullptr
+    std::unique_ptr<connection> shared_cache_pool::take_reader(bool wait)
+    {
+      std::unique_lock<std::mutex> lock(_state->mutex);
+      const auto available = [this]() {
+        return not _state->idle_readers.empty() or _state->open_readers < _state->max_readers;
+      };
+      if (wait)
+        _state->available.wait(lock, available);
+      else if (not available())
+        return nullptr;
+      if (not _state->idle_readers.empty())
+      {
+        auto db = std::move(_state->idle_readers.back());
+        _state->idle_readers.pop_back();
+        return db;
+      }
+
+      // opening may take a while, do not block others meanwhile
+      ++_state->open_readers;
+      lock.unlock();
+      try
+      {
+        return _state->open_reader();
+      }
+      catch (...)
+      {
+        lock.lock();
+        --_state->open_readers;
+        _state->available.notify_one();
+        throw;
+      }
+    }
+
+    size_t shared_cache_pool::open_readers() const
+    {
+      std::lock_guard<std::mutex> lock(_state->mutex);
+      return _state->open_readers;
+    }
+
+    bool shared_cache_pool::is_read_only(connection& db, const std::string& statement)
+    {
+      const auto read_only = db.is_read_only(statement);
+      std::lock_guard<std::mutex> lock(_state->read_only_mutex);
+      if (_state->read_only_statements.size() < max_cached_classifications)
+        _state->read_only_statements.emplace(statement, read_only);
+      return read_only;
+    }
+
+    const connection& shared_cache_pool::serializing_connection() const
+    {
+      return *_state->serializing_connection;
+    }
+
+    pooled_connection shared_cache_pool::borrow_for(const std::string& statement)
+    {
+      {
+        std::unique_lock<std::mutex> lock(_state->read_only_mutex);
+        const auto it = _state->read_only_statements.find(statement);
+        if (it != _state->read_only_statements.end())
+        {
+          const auto read_only = it->second;
+          lock.unlock();
+          return read_only ? reader() : writer();
+        }
+      }
+
+      // classify on a reader if one is available right away, on the writer otherwise: writes must not wait for
+      // readers
+      if (auto db = take_reader(false))
+      {
+        pooled_connection borrowed(*this, std::move(db), false);
+        if (is_read_only(*borrowed, statement))
+          return borrowed;
+        borrowed.release();
+        return writer();
+      }
+      auto borrowed = writer();
+      if (not is_read_only(*borrowed, statement))
+        return borrowed;
+      borrowed.release();
+      return reader();
+    }
+
+    void shared_cache_pool::give_back(std::unique_ptr<connection> db, bool writer)
+    {
+      {
+        std::lock_guard<std::mutex> lock(_state->mutex);
+        if (writer)
+          _state->writer = std::move(db);
+        else
+          _state->idle_readers.push_back(std::move(db));
+      }
+      _state->available.notify_all();
+    }
+  }  // namespace sqlite3
+}  // namespace sqlpp
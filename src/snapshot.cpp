@@ -0,0 +1,151 @@
+/*
+ * Copyright (c) 2013 - 2016, Roland Bock
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ *   Redistributions of source code must retain the above copyright notice, this
+ *   list of conditions and the following disclaimer.
+ *
+ *   Redistributions in binary form must reproduce the above copyright notice, this
+ *   list of conditions and the following disclaimer in the documentation and/or
+ *   other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON
+ * ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifdef SQLPP_USE_SQLCIPHER
+#include <sqlcipher/sqlite3.h>
+#else
+#include <sqlite3.h>
+#endif
+#include <sqlpp11/exception.h>
+#include <sqlpp11/sqlite3/connection.h>
+#include <sqlpp11/sqlite3/snapshot.h>
+
+#ifdef SQLPP_DYNAMIC_LOADING
+#include <sqlpp11/sqlite3/dynamic_libsqlite3.h>
+#endif
+
+// the snapshot functions are only linkable if sqlite3 was compiled with SQLITE_ENABLE_SNAPSHOT
+#if defined(SQLITE_ENABLE_SNAPSHOT) or (defined(SQLPP_DYNAMIC_LOADING) and SQLITE_VERSION_NUMBER >= 3010000)
+#define SQLPP_SQLITE3_HAS_SNAPSHOT
+#endif
+
+namespace sqlpp
+{
+  namespace sqlite3
+  {
+#ifdef SQLPP_DYNAMIC_LOADING
+    using namespace dynamic;
+#endif
+
+    namespace
+    {
+      // with dynamic loading, optional functions are nullptr if the library does not provide them
+      template <typename Function>
+      bool is_loaded(Function* function)
+      {
+        return function != nullptr;
+      }
+
+      void check_snapshot_support()
+      {
+#ifdef SQLPP_SQLITE3_HAS_SNAPSHOT
+        if (runtime_features().snapshot and is_loaded(sqlite3_snapshot_get) and is_loaded(sqlite3_snapshot_open) and
+            is_loaded(sqlite3_snapshot_free))
+        {
+          return;
+        }
+#endif
+        throw sqlpp::exception("Sqlite3 error: snapshots not supported by sqlite3 " +
+                               std::to_string(runtime_features().version_number) +
+                               " (requires SQLITE_ENABLE_SNAPSHOT)");
+      }
+    }  // namespace
+
+    snapshot::snapshot(connection& db, const std::string& schema) : _schema(schema)
+    {
+      check_snapshot_support();
+#ifdef SQLPP_SQLITE3_HAS_SNAPSHOT
+      const bool started = db.transaction_depth() == 0;
+      if (started)
+        db.start_transaction(transaction_mode::deferred);
+      try
+      {
+        // the read transaction starts with the first read
+        db.execute("SELECT count(*) FROM " + _schema + ".sqlite_master");
+        if (sqlite3_snapshot_get(db.native_handle(), _schema.c_str(), &_snapshot) != SQLITE_OK)
+        {
+          throw sqlpp::exception("Sqlite3 error: Could not get snapshot of schema " + _schema + ": " +
+                                 std::string(sqlite3_errmsg(db.native_handle())));
+        }
+      }
+      catch (...)
+      {
+        if (started)
+          db.rollback_transaction(false);
+        throw;
+      }
+#else
+      (void)db;
+#endif
+    }
+
+    snapshot::snapshot(snapshot&& rhs) noexcept : _snapshot(rhs._snapshot), _schema(std::move(rhs._schema))
+    {
+      rhs._snapshot = nullptr;
+    }
+
+    snapshot& snapshot::operator=(snapshot&& rhs) noexcept
+    {
+      if (this != &rhs)
+      {
+        std::swap(_snapshot, rhs._snapshot);
+        std::swap(_schema, rhs._schema);
+      }
+      return *this;
+    }
+
+    snapshot::~snapshot()
+    {
+#ifdef SQLPP_SQLITE3_HAS_SNAPSHOT
+      if (_snapshot)
+        sqlite3_snapshot_free(_snapshot);
+#endif
+    }
+
+    void snapshot::open(connection& db) const
+    {
+      check_snapshot_support();
+      if (not _snapshot)
+      {
+        throw sqlpp::exception("Sqlite3 error: Cannot open a moved-from snapshot");
+      }
+      if (db.transaction_depth() != 0)
+      {
+        throw sqlpp::exception("Sqlite3 error: Cannot open a snapshot within a transaction");
+      }
+#ifdef SQLPP_SQLITE3_HAS_SNAPSHOT
+      db.start_transaction(transaction_mode::deferred);
+      if (sqlite3_snapshot_open(db.native_handle(), _schema.c_str(), _snapshot) != SQLITE_OK)
+      {
+        // e.g. SQLITE_ERROR_SNAPSHOT if a checkpoint discarded the snapshot meanwhile
+        const std::string msg = sqlite3_errmsg(db.native_handle());
+        db.rollback_transaction(false);
+        throw sqlpp::exception("Sqlite3 error: Could not open snapshot of schema " + _schema + ": " + msg);
+      }
+#endif
+    }
+  }  // namespace sqlite3
+}  // namespace sqlpp
@@ -0,0 +1,82 @@
+/*
+ * Copyright (c) 2013 - 2016, Roland Bock
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ *   Redistributions of source code must retain the above copyright notice, this
+ *   list of conditions and the following disclaimer.
+ *
+ *   Redistributions in binary form must reproduce the above copyright notice, this
+ *   list of conditions and the following disclaimer in the documentation and/or
+ *   other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON
+ * ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifdef SQLPP_USE_SQLCIPHER
+#include <sqlcipher/sqlite3.h>
+#else
+#include <sqlite3.h>
+#endif
+#include <mutex>
+#include <sqlpp11/exception.h>
+#include <sqlpp11/sqlite3/statistics.h>
+#include <string>
+
+#ifdef SQLPP_DYNAMIC_LOADING
+#include <sqlpp11/sqlite3/dynamic_libsqlite3.h>
+#endif
+
+namespace sqlpp
+{
+  namespace sqlite3
+  {
+#ifdef SQLPP_DYNAMIC_LOADING
+    using namespace dynamic;
+#endif
+
+    namespace
+    {
+      void read_status(status_gauge& gauge, const status_gauge& previous, int op)
+      {
+        sqlite3_int64 current = 0;
+        sqlite3_int64 highwater = 0;
+        const auto rc = sqlite3_status64(op, &current, &highwater, 0);
+        if (rc != SQLITE_OK)
+          throw sqlpp::exception("Sqlite3 error: Could not read status " + std::to_string(op) + ": " +
+                                 std::string(sqlite3_errstr(rc)));
+        gauge.current = current;
+        gauge.highwater = highwater;
+        gauge.delta = current - previous.current;
+      }
+    }  // namespace
+
+    global_stats global_statistics()
+    {
+      static std::mutex mutex;
+      static global_stats previous;
+
+      global_stats stats;
+      std::lock_guard<std::mutex> lock(mutex);
+      read_status(stats.memory_used, previous.memory_used, SQLITE_STATUS_MEMORY_USED);
+      read_status(stats.malloc_count, previous.malloc_count, SQLITE_STATUS_MALLOC_COUNT);
+      read_status(stats.malloc_size, previous.malloc_size, SQLITE_STATUS_MALLOC_SIZE);
+      read_status(stats.pagecache_used, previous.pagecache_used, SQLITE_STATUS_PAGECACHE_USED);
+      read_status(stats.pagecache_overflow, previous.pagecache_overflow, SQLITE_STATUS_PAGECACHE_OVERFLOW);
+      read_status(stats.pagecache_size, previous.pagecache_size, SQLITE_STATUS_PAGECACHE_SIZE);
+      previous = stats;
+      return stats;
+    }
+  }  // namespace sqlite3
+}  // namespace sqlpp
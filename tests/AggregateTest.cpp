@@ -0,0 +1,173 @@
+/*
+ * Copyright (c) 2015 - 2016, Roland Bock
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ *  * Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ * LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE
+ * OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ * OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "TabSample.h"
+#include <cassert>
+#include <sqlpp11/custom_query.h>
+#include <sqlpp11/sqlite3/connection.h>
+#include <sqlpp11/sqlpp11.h>
+
+#ifdef SQLPP_USE_SQLCIPHER
+#include <sqlcipher/sqlite3.h>
+#else
+#include <sqlite3.h>
+#endif
+#include <algorithm>
+#include <iostream>
+#include <vector>
+
+namespace sql = sqlpp::sqlite3;
+
+SQLPP_ALIAS_PROVIDER(result)
+
+namespace
+{
+  int live_sums = 0;
+
+  struct running_sum
+  {
+    int64_t sum = 0;
+
+    running_sum()
+    {
+      ++live_sums;
+    }
+    ~running_sum()
+    {
+      --live_sums;
+    }
+
+    void step(int64_t value)
+    {
+      sum += value;
+    }
+    void inverse(int64_t value)
+    {
+      sum -= value;
+    }
+    int64_t value() const
+    {
+      return sum;
+    }
+    int64_t final() const
+    {
+      return sum;
+    }
+  };
+
+  struct median
+  {
+    std::vector<double> values;
+
+    void step(double value)
+    {
+      values.push_back(value);
+    }
+    double final()
+    {
+      if (values.empty())
+        return 0.0;
+      std::sort(values.begin(), values.end());
+      return values[values.size() / 2];
+    }
+  };
+}
+
+int main()
+{
+  sql::connection_config config;
+  config.path_to_database = ":memory:";
+  config.flags = SQLITE_OPEN_READWRITE | SQLITE_OPEN_CREATE;
+  config.debug = true;
+
+  sql::connection db(config);
+  db.execute(R"(CREATE TABLE tab_sample (
+		alpha INTEGER PRIMARY KEY,
+			beta varchar(255) DEFAULT NULL,
+			gamma bool DEFAULT NULL
+			))");
+
+  const auto tab = TabSample{};
+  for (int i = 0; i < 10; ++i)
+  {
+    db(insert_into(tab).set(tab.beta = "row " + std::to_string(i), tab.gamma = (i % 2 == 0)));
+  }
+
+  db.register_aggregate<running_sum>("my_sum", SQLITE_DETERMINISTIC);
+  db.register_aggregate<median>("median", SQLITE_DETERMINISTIC);
+
+  // alpha is 1..10
+  const auto total = db(select(sqlpp::verbatim<sqlpp::integer>("my_sum(alpha)").as(result)).from(tab).unconditionally())
+                         .front()
+                         .result;
+  std::cerr << "my_sum: " << total << std::endl;
+  assert(total == 55);
+
+  auto group_total = int64_t{0};
+  for (const auto& row : db(select(sqlpp::verbatim<sqlpp::integer>("my_sum(alpha)").as(result))
+                                .from(tab)
+                                .unconditionally()
+                                .group_by(tab.gamma)))
+  {
+    group_total += row.result;
+  }
+  assert(group_total == 55);
+
+  // An aggregate over no rows still produces a result
+  const auto empty = db(select(sqlpp::verbatim<sqlpp::integer>("my_sum(alpha)").as(result))
+                            .from(tab)
+                            .where(tab.alpha > 100))
+                         .front()
+                         .result;
+  assert(empty == 0);
+
+  const auto middle = db(select(sqlpp::verbatim<sqlpp::floating_point>("median(alpha)").as(result))
+                             .from(tab)
+                             .unconditionally())
+                          .front()
+                          .result;
+  std::cerr << "median: " << middle << std::endl;
+  assert(middle == 6.0);
+
+#if SQLITE_VERSION_NUMBER >= 3025000
+  db.register_window_function<running_sum>("window_sum", SQLITE_DETERMINISTIC);
+  auto expected = int64_t{1};
+  for (const auto& row :
+       db(custom_query(sqlpp::verbatim(
+                           "SELECT window_sum(alpha) OVER (ORDER BY alpha ROWS BETWEEN 1 PRECEDING AND CURRENT ROW) "
+                           "FROM tab_sample"))
+              .with_result_type_of(select(sqlpp::value(0).as(result)))))
+  {
+    assert(row.result == expected);
+    expected += 2;
+  }
+  assert(expected == 21);
+#endif
+
+  // all per-group states have been destroyed
+  assert(live_sums == 0);
+
+  return 0;
+}
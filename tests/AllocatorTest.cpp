@@ -0,0 +1,133 @@
+/*
+ * Copyright (c) 2015 - 2016, Roland Bock
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ *  * Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ * LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE
+ * OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ * OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+#include "TabSample.h"
+#include <cassert>
+#include <sqlpp11/sqlite3/connection.h>
+#include <sqlpp11/sqlite3/initialize.h>
+#include <sqlpp11/sqlpp11.h>
+
+#ifdef SQLPP_USE_SQLCIPHER
+#include <sqlcipher/sqlite3.h>
+#else
+#include <sqlite3.h>
+#endif
+#include <iostream>
+#include <thread>
+#include <vector>
+
+namespace sql = sqlpp::sqlite3;
+
+namespace
+{
+  // destroyed after the allocator's thread cache if it is constructed before the thread's first allocation
+  struct late_free
+  {
+    void* block = nullptr;
+
+    ~late_free()
+    {
+      sqlite3_free(block);
+      sqlite3_free(sqlite3_malloc(100));
+    }
+  };
+}  // namespace
+
+int main()
+{
+  // must happen before sqlite3 is used in any other way
+  sql::global_config global;
+  global.slab_allocator = true;
+  global.thread_cache_blocks = 16;
+  sql::initialize(global);
+
+  sql::connection_config config;
+  config.path_to_database = ":memory:";
+  config.flags = SQLITE_OPEN_READWRITE | SQLITE_OPEN_CREATE;
+  config.debug = true;
+  config.lookaside_slot_size = 256;
+  config.lookaside_slot_count = 64;
+
+  const auto tab = TabSample{};
+  std::vector<std::thread> threads;
+  for (int t = 0; t < 4; ++t)
+  {
+    threads.emplace_back([&config, &tab]() {
+      sql::connection db(config);
+      db.execute(R"(CREATE TABLE tab_sample (
+		alpha INTEGER PRIMARY KEY,
+			beta varchar(255) DEFAULT NULL,
+			gamma bool DEFAULT NULL
+			))");
+      for (int i = 0; i < 200; ++i)
+      {
+        db(insert_into(tab).set(tab.beta = std::string(static_cast<size_t>(i) * 50, 'x'), tab.gamma = true));
+      }
+      int count = 0;
+      for (const auto& row : db(select(tab.alpha, tab.beta).from(tab).unconditionally()))
+      {
+        assert(row.beta.value().size() == static_cast<size_t>(row.alpha - 1) * 50);
+        ++count;
+      }
+      assert(count == 200);
+    });
+  }
+  for (auto& thread : threads)
+    thread.join();
+
+  const auto stats = sql::allocator_statistics();
+  std::cerr << "allocations: " << stats.allocations << ", frees: " << stats.frees
+            << ", in use: " << stats.bytes_in_use << ", large: " << stats.large_allocations
+            << ", cache hits: " << stats.thread_cache_hits << ", slab bytes: " << stats.slab_bytes << std::endl;
+  assert(stats.allocations > 0);
+  assert(stats.frees > 0);
+  assert(stats.large_allocations > 0);
+  assert(stats.thread_cache_hits > 0);
+  assert(stats.slab_bytes > 0);
+  assert(stats.bytes_in_use >= 0);
+
+  // memory freed during thread exit, after the thread's cache is gone, is still accounted for
+  const auto before = sql::allocator_statistics();
+  std::thread exiting([]() {
+    thread_local late_free guard;
+    guard.block = sqlite3_malloc(64);
+  });
+  exiting.join();
+  const auto after = sql::allocator_statistics();
+  assert(after.allocations - before.allocations == 2);
+  assert(after.frees - before.frees == 2);
+  assert(after.bytes_in_use == before.bytes_in_use);
+
+  // too late to exchange the allocator now
+  try
+  {
+    sql::initialize(global);
+    assert(false);
+  }
+  catch (const sqlpp::exception&)
+  {
+  }
+
+  return 0;
+}
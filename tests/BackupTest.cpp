@@ -0,0 +1,87 @@
+/*
+ * Copyright (c) 2013 - 2016, Roland Bock
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ *   Redistributions of source code must retain the above copyright notice, this
+ *   list of conditions and the following disclaimer.
+ *
+ *   Redistributions in binary form must reproduce the above copyright notice, this
+ *   list of conditions and the following disclaimer in the documentation and/or
+ *   other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON
+ * ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "TabSample.h"
+#include <cassert>
+#include <sqlpp11/sqlite3/connection.h>
+#include <sqlpp11/sqlpp11.h>
+
+#ifdef SQLPP_USE_SQLCIPHER
+#include <sqlcipher/sqlite3.h>
+#else
+#include <sqlite3.h>
+#endif
+#include <iostream>
+#include <vector>
+
+namespace sql = sqlpp::sqlite3;
+
+int main()
+{
+  sql::connection_config config;
+  config.path_to_database = ":memory:";
+  config.flags = SQLITE_OPEN_READWRITE | SQLITE_OPEN_CREATE;
+  config.debug = true;
+
+  sql::connection db(config);
+  db.execute(R"(CREATE TABLE tab_sample (
+		alpha INTEGER PRIMARY KEY,
+			beta varchar(255) DEFAULT NULL,
+			gamma bool DEFAULT NULL
+			))");
+
+  const auto tab = TabSample{};
+  for (int i = 0; i < 1000; ++i)
+  {
+    db(insert_into(tab).set(tab.beta = std::string(100, 'x'), tab.gamma = (i % 2 == 0)));
+  }
+
+  // Copying the database into another in-memory database, a few pages at a time
+  sql::connection standby(config);
+  auto steps = 0;
+  auto last_remaining = -1;
+  db.backup_to(standby, 4, std::chrono::milliseconds(0), [&](int remaining, int page_count) {
+    std::cerr << "Backup progress: " << remaining << " of " << page_count << " pages remaining" << std::endl;
+    assert(remaining <= page_count);
+    ++steps;
+    last_remaining = remaining;
+  });
+  assert(steps > 1);
+  assert(last_remaining == 0);
+
+  const auto row_count = standby(select(count(tab.alpha)).from(tab).unconditionally()).front().count;
+  std::cerr << "Expecting 1000 rows in the copy, found " << row_count << std::endl;
+  assert(row_count == 1000);
+
+  // The source remains usable and independent of the copy
+  db(remove_from(tab).unconditionally());
+  assert(standby(select(count(tab.alpha)).from(tab).unconditionally()).front().count == 1000);
+
+  // Copying in one go into a database opened from a config
+  db.backup_to(config);
+
+  return 0;
+}
@@ -0,0 +1,136 @@
+/*
+ * Copyright (c) 2015 - 2016, Roland Bock
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ *  * Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ * LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE
+ * OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ * OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "BlobSample.h"
+#include <cassert>
+#include <sqlpp11/sqlite3/sqlite3.h>
+#include <sqlpp11/sqlpp11.h>
+
+#ifdef SQLPP_USE_SQLCIPHER
+#include <sqlcipher/sqlite3.h>
+#else
+#include <sqlite3.h>
+#endif
+#include <algorithm>
+#include <iostream>
+#include <vector>
+
+namespace sql = sqlpp::sqlite3;
+const auto blob = BlobSample{};
+
+constexpr size_t blob_size = 3 * 1000 * 1000ul;
+constexpr size_t chunk_size = 64 * 1024ul;
+
+SQLPP_ALIAS_PROVIDER(size)
+
+namespace
+{
+  uint8_t pattern(size_t offset)
+  {
+    return static_cast<uint8_t>(offset % 251);
+  }
+}
+
+int main()
+{
+  sql::connection_config config;
+  config.path_to_database = ":memory:";
+  config.flags = SQLITE_OPEN_READWRITE | SQLITE_OPEN_CREATE;
+  config.debug = true;
+
+  sql::connection db(config);
+  db.execute(R"(CREATE TABLE blob_sample (
+             id INTEGER PRIMARY KEY,
+             data blob
+           ))");
+
+  // preallocate, then stream the content chunk by chunk
+  const auto id = db(insert_into(blob).set(blob.data = sql::zeroblob(blob_size)));
+  auto prepared_insert =
+      db.prepare(insert_into(blob).set(blob.data = sql::zeroblob(parameter(sqlpp::integral(), size))));
+  prepared_insert.params.size = 10;
+  const auto small_id = db(prepared_insert);
+
+  auto chunk = std::vector<uint8_t>(chunk_size);
+  {
+    auto stream = db.open_blob("blob_sample", "data", static_cast<int64_t>(id), true);
+    assert(stream.size() == blob_size);
+    for (size_t offset = 0; offset < blob_size; offset += chunk_size)
+    {
+      const auto count = std::min(chunk_size, blob_size - offset);
+      for (size_t i = 0; i < count; ++i)
+      {
+        chunk[i] = pattern(offset + i);
+      }
+      stream.write(chunk.data(), count);
+    }
+    assert(stream.tell() == blob_size);
+
+    // writing beyond the end is an error, the size of a blob cannot change
+    try
+    {
+      stream.write(chunk.data(), 1);
+      assert(false);
+    }
+    catch (const sqlpp::exception& e)
+    {
+      std::cerr << "Expected exception: " << e.what() << std::endl;
+    }
+  }
+
+  {
+    auto stream = db.open_blob("blob_sample", "data", static_cast<int64_t>(id));
+    size_t total = 0;
+    while (const auto count = stream.read(chunk.data(), chunk.size()))
+    {
+      for (size_t i = 0; i < count; ++i)
+      {
+        assert(chunk[i] == pattern(total + i));
+      }
+      total += count;
+    }
+    assert(total == blob_size);
+
+    // random access and moving to another row
+    assert(stream.read(chunk.data(), 10, blob_size - 5) == 5);
+    assert(chunk[0] == pattern(blob_size - 5));
+    stream.reopen(static_cast<int64_t>(small_id));
+    assert(stream.size() == 10);
+    assert(stream.read(chunk.data(), chunk.size()) == 10);
+    assert(std::all_of(chunk.begin(), chunk.begin() + 10, [](uint8_t c) { return c == 0; }));
+  }
+
+  try
+  {
+    db.open_blob("blob_sample", "data", 4711);
+    assert(false);
+  }
+  catch (const sqlpp::exception& e)
+  {
+    std::cerr << "Expected exception: " << e.what() << std::endl;
+  }
+
+  return 0;
+}
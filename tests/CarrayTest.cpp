@@ -0,0 +1,89 @@
+/*
+ * Copyright (c) 2015 - 2016, Roland Bock
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ *  * Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ * LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE
+ * OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ * OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "TabSample.h"
+#include <cassert>
+#include <sqlpp11/sqlite3/sqlite3.h>
+#include <sqlpp11/sqlpp11.h>
+
+#ifdef SQLPP_USE_SQLCIPHER
+#include <sqlcipher/sqlite3.h>
+#else
+#include <sqlite3.h>
+#endif
+#include <iostream>
+#include <string>
+#include <vector>
+
+namespace sql = sqlpp::sqlite3;
+
+SQLPP_ALIAS_PROVIDER(names)
+
+int main()
+{
+#if SQLITE_VERSION_NUMBER >= 3020000
+  sql::connection_config config;
+  config.path_to_database = ":memory:";
+  config.flags = SQLITE_OPEN_READWRITE | SQLITE_OPEN_CREATE;
+  config.debug = true;
+
+  sql::connection db(config);
+  db.execute(R"(CREATE TABLE tab_sample (
+		alpha INTEGER PRIMARY KEY,
+			beta varchar(255) DEFAULT NULL,
+			gamma bool DEFAULT NULL
+			))");
+
+  const auto tab = TabSample{};
+  for (int i = 0; i < 10; ++i)
+  {
+    db(insert_into(tab).set(tab.beta = "row " + std::to_string(i), tab.gamma = (i % 2 == 0)));
+  }
+
+  // one statement for lists of any size
+  auto prepared = db.prepare(select(tab.alpha).from(tab).where(tab.alpha.in(sql::carray(tab.alpha))));
+  for (const auto& ids : {std::vector<int64_t>{}, std::vector<int64_t>{3}, std::vector<int64_t>{1, 2, 4, 8, 16}})
+  {
+    prepared.params.alpha = ids;
+    auto found = std::vector<int64_t>{};
+    for (const auto& row : db(prepared))
+    {
+      found.push_back(row.alpha);
+    }
+    std::cerr << "found " << found.size() << " rows" << std::endl;
+    assert(found.size() == (ids.size() == 5 ? 4u : ids.size()));
+  }
+
+  auto excluded = db.prepare(select(count(tab.alpha))
+                                 .from(tab)
+                                 .where(tab.beta.not_in(sql::carray(sqlpp::text(), names))));
+  excluded.params.names = std::vector<std::string>{"row 0", "row 1", "no such row"};
+  const auto row_count = db(excluded).front().count;
+  std::cerr << "rows not excluded: " << row_count << std::endl;
+  assert(row_count == 8);
+#endif
+
+  return 0;
+}
@@ -0,0 +1,228 @@
+/*
+ * Copyright (c) 2015 - 2016, Roland Bock
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ *  * Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ * LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE
+ * OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ * OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+#include "TabSample.h"
+#include <cassert>
+#include <sqlpp11/exception.h>
+#include <sqlpp11/sqlite3/change_stream.h>
+#include <sqlpp11/sqlite3/connection.h>
+#include <sqlpp11/sqlite3/logger.h>
+#include <sqlpp11/sqlpp11.h>
+
+#ifdef SQLPP_USE_SQLCIPHER
+#include <sqlcipher/sqlite3.h>
+#else
+#include <sqlite3.h>
+#endif
+#include <cstdio>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <vector>
+
+namespace sql = sqlpp::sqlite3;
+
+namespace
+{
+  struct collecting_logger : public sql::logger
+  {
+    std::mutex mutex;
+    std::vector<sql::log_record> records;
+
+    void log(const sql::log_record& record) override
+    {
+      std::lock_guard<std::mutex> lock(mutex);
+      records.push_back(record);
+    }
+  };
+}  // namespace
+
+int main()
+{
+  sql::connection_config config;
+  config.path_to_database = ":memory:";
+  config.flags = SQLITE_OPEN_READWRITE | SQLITE_OPEN_CREATE;
+  config.debug = true;
+
+  sql::connection db(config);
+  db.execute(R"(CREATE TABLE tab_sample (
+		alpha INTEGER PRIMARY KEY,
+			beta varchar(255) DEFAULT NULL,
+			gamma bool DEFAULT NULL
+			))");
+
+  std::mutex mutex;
+  std::vector<sql::row_change> published;
+  const auto publish = [&](const sql::row_change& change) {
+    std::lock_guard<std::mutex> lock(mutex);
+    published.push_back(change);
+  };
+
+#ifndef SQLITE_ENABLE_PREUPDATE_HOOK
+  // not built with SQLITE3_ENABLE_PREUPDATE_HOOK
+  try
+  {
+    sql::change_stream unavailable(db, publish);
+    assert(false);
+  }
+  catch (const sqlpp::exception& e)
+  {
+    std::cerr << "preupdate hook not available: " << e.what() << std::endl;
+  }
+  return 77;  // skipped
+#endif
+  assert(sql::runtime_features().preupdate_hook);
+
+  // a small queue makes the connection wait for the publisher now and then
+  std::unique_ptr<sql::change_stream> stream(new sql::change_stream(db, publish, 4));
+
+  const auto tab = TabSample{};
+  {
+    auto tx = start_transaction(db);
+    for (int64_t i = 1; i <= 20; ++i)
+      db(insert_into(tab).set(tab.alpha = i, tab.beta = "inserted", tab.gamma = true));
+    tx.commit();
+  }
+
+  // rolled back changes are not published
+  {
+    auto tx = start_transaction(db);
+    db(remove_from(tab).unconditionally());
+    tx.rollback();
+  }
+
+  // neither are changes undone by rolling back to a savepoint
+  {
+    auto tx = start_transaction(db);
+    db(insert_into(tab).set(tab.alpha = 21, tab.beta = "inserted", tab.gamma = true));
+    {
+      auto nested = start_transaction(db);
+      db(remove_from(tab).unconditionally());
+      nested.rollback();
+    }
+    tx.commit();
+  }
+
+  db(update(tab).set(tab.beta = sqlpp::null).where(tab.alpha == 7));
+  db(remove_from(tab).where(tab.alpha == 8));
+
+  stream->flush();
+  assert(stream->published() == 23);
+  stream.reset();
+
+  assert(published.size() == 23);
+  for (size_t i = 0; i < 21; ++i)
+  {
+    const auto& change = published[i];
+    assert(change.operation == sql::change_operation::insert);
+    assert(change.schema == "main");
+    assert(change.table == "tab_sample");
+    assert(change.new_rowid == static_cast<int64_t>(i + 1));
+    assert(change.old_values.empty());
+    assert(change.new_values.size() == 3);
+    assert(change.new_values[0].type == sql::value_type::integer);
+    assert(change.new_values[0].integer == change.new_rowid);
+    assert(change.new_values[1].type == sql::value_type::text);
+    assert(change.new_values[1].bytes == "inserted");
+  }
+
+  const auto& updated = published[21];
+  assert(updated.operation == sql::change_operation::update);
+  assert(updated.old_rowid == 7 and updated.new_rowid == 7);
+  assert(updated.old_values[1].bytes == "inserted");
+  assert(updated.new_values[1].is_null());
+
+  const auto& removed = published[22];
+  assert(removed.operation == sql::change_operation::remove);
+  assert(removed.old_rowid == 8);
+  assert(removed.new_values.empty());
+  assert(removed.old_values[2].integer == 1);
+
+  // the stream detached from the connection
+  db(insert_into(tab).set(tab.alpha = 100));
+  assert(published.size() == 23);
+
+  // changes are not published before their commit has succeeded, locking between connections requires a file
+  const auto path = std::string("change_stream_test.db");
+  std::remove(path.c_str());
+  config.path_to_database = path;
+  {
+    sql::connection writer(config);
+    sql::connection reader(config);
+    writer.execute("CREATE TABLE tab_sample (alpha INTEGER PRIMARY KEY, beta varchar(255), gamma bool)");
+    published.clear();
+    sql::change_stream file_stream(writer, publish);
+
+    // the reader's shared lock makes the COMMIT fail with SQLITE_BUSY
+    reader.execute("BEGIN");
+    reader.execute("SELECT count(*) FROM tab_sample");
+    writer.start_transaction();
+    writer(insert_into(tab).set(tab.alpha = 1));
+    try
+    {
+      writer.commit_transaction();
+      assert(false);
+    }
+    catch (const sqlpp::exception&)
+    {
+    }
+    file_stream.flush();
+    assert(file_stream.published() == 0);
+    writer.rollback_transaction(false);
+    reader.execute("COMMIT");
+
+    writer(insert_into(tab).set(tab.alpha = 2));
+    file_stream.flush();
+    std::lock_guard<std::mutex> lock(mutex);
+    assert(published.size() == 1);
+    assert(published.front().new_rowid == 2);
+  }
+  std::remove(path.c_str());
+
+  // failing publishers are reported to the connection's logger
+  auto collector = std::make_shared<collecting_logger>();
+  config.path_to_database = ":memory:";
+  config.debug = false;
+  config.log = collector;
+  {
+    sql::connection logged(config);
+    logged.execute("CREATE TABLE tab_sample (alpha INTEGER PRIMARY KEY, beta varchar(255), gamma bool)");
+    sql::change_stream failing(logged, [](const sql::row_change& change) {
+      if (change.new_rowid == 1)
+        throw std::runtime_error("unavailable");
+      throw change.new_rowid;  // not derived from std::exception
+    });
+    logged(insert_into(tab).set(tab.alpha = 1));
+    logged(insert_into(tab).set(tab.alpha = 2));
+    failing.flush();
+    assert(failing.published() == 2);
+  }
+  assert(collector->records.size() == 2);
+  assert(collector->records.front().level == sql::log_level::warning);
+  assert(collector->records.front().message == "Publishing a change of tab_sample failed: unavailable");
+  assert(collector->records.back().message == "Publishing a change of tab_sample failed: unknown exception");
+
+  return 0;
+}
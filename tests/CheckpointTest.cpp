@@ -0,0 +1,121 @@
+/*
+ * Copyright (c) 2015 - 2016, Roland Bock
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ *  * Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ * LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE
+ * OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ * OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "TabSample.h"
+#include <cassert>
+#include <sqlpp11/sqlite3/checkpointer.h>
+#include <sqlpp11/sqlite3/connection.h>
+#include <sqlpp11/sqlpp11.h>
+
+#ifdef SQLPP_USE_SQLCIPHER
+#include <sqlcipher/sqlite3.h>
+#else
+#include <sqlite3.h>
+#endif
+#include <cstdio>
+#include <iostream>
+#include <thread>
+
+namespace sql = sqlpp::sqlite3;
+
+namespace
+{
+  int autocheckpoint(sql::connection& db)
+  {
+    sqlite3_stmt* statement = nullptr;
+    sqlite3_prepare_v2(db.native_handle(), "PRAGMA wal_autocheckpoint", -1, &statement, nullptr);
+    sqlite3_step(statement);
+    const auto frames = sqlite3_column_int(statement, 0);
+    sqlite3_finalize(statement);
+    return frames;
+  }
+}  // namespace
+
+int main()
+{
+  // WAL mode requires a database file
+  const auto path = std::string("checkpoint_test.db");
+  std::remove(path.c_str());
+
+  sql::connection_config config;
+  config.path_to_database = path;
+  config.flags = SQLITE_OPEN_READWRITE | SQLITE_OPEN_CREATE;
+  config.debug = true;
+
+  {
+    sql::connection db(config);
+    db.execute("PRAGMA journal_mode = WAL");
+    db.execute(R"(CREATE TABLE tab_sample (
+		alpha INTEGER PRIMARY KEY,
+			beta varchar(255) DEFAULT NULL,
+			gamma bool DEFAULT NULL
+			))");
+
+    const auto tab = TabSample{};
+    {
+      sql::background_checkpointer checkpointer(config, sql::checkpoint_mode::passive, 10);
+      db.execute("PRAGMA wal_autocheckpoint = 321");
+      checkpointer.watch(db);
+
+      for (int i = 0; i < 100; ++i)
+      {
+        db(insert_into(tab).set(tab.beta = std::string(1000, 'x'), tab.gamma = true));
+      }
+
+      for (int i = 0; i < 500 and checkpointer.checkpoint_count() == 0; ++i)
+      {
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+      }
+      std::cerr << "Background checkpoints: " << checkpointer.checkpoint_count()
+                << ", last result: " << checkpointer.last_result().checkpointed_frames << " of "
+                << checkpointer.last_result().log_frames << " frames" << std::endl;
+      assert(checkpointer.checkpoint_count() > 0);
+      assert(checkpointer.last_result().log_frames >= 0);
+
+      checkpointer.unwatch(db);
+      assert(autocheckpoint(db) == 321);
+    }
+
+    const auto result = db.checkpoint(sql::checkpoint_mode::truncate);
+    std::cerr << "Truncating checkpoint: " << result.checkpointed_frames << " of " << result.log_frames << " frames"
+              << std::endl;
+    assert(not result.busy);
+    assert(result.log_frames == 0);
+  }
+
+  {
+    // Not in WAL mode
+    config.path_to_database = ":memory:";
+    sql::connection db(config);
+    const auto result = db.checkpoint();
+    assert(result.log_frames == -1);
+  }
+
+  std::remove(path.c_str());
+  std::remove((path + "-wal").c_str());
+  std::remove((path + "-shm").c_str());
+
+  return 0;
+}
@@ -0,0 +1,182 @@
+/*
+ * Copyright (c) 2015 - 2016, Roland Bock
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ *  * Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ * LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE
+ * OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ * OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "TabSample.h"
+#include <cassert>
+#include <functional>
+#include <sqlpp11/custom_query.h>
+#include <sqlpp11/exception.h>
+#include <sqlpp11/sqlite3/connection.h>
+#include <sqlpp11/sqlpp11.h>
+
+#ifdef SQLPP_USE_SQLCIPHER
+#include <sqlcipher/sqlite3.h>
+#else
+#include <sqlite3.h>
+#endif
+#include <iostream>
+#include <map>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace sql = sqlpp::sqlite3;
+
+SQLPP_ALIAS_PROVIDER(result)
+
+namespace
+{
+  struct session
+  {
+    std::string user;
+    double load;
+  };
+
+  using sessions_t = std::map<int64_t, session>;
+
+  int64_t session_id(const sessions_t::value_type& entry)
+  {
+    return entry.first;
+  }
+
+  const std::string& session_user(const sessions_t::value_type& entry)
+  {
+    return entry.second.user;
+  }
+
+  int64_t failing_value(int64_t value)
+  {
+    if (value == 5)
+      throw value;  // not derived from std::exception
+    return value;
+  }
+
+  int64_t sum_of(sql::connection& db, const std::string& query)
+  {
+    auto sum = int64_t{0};
+    for (const auto& row :
+         db(custom_query(sqlpp::verbatim(query)).with_result_type_of(select(sqlpp::value(0).as(result)))))
+    {
+      sum += row.result;
+    }
+    return sum;
+  }
+}
+
+int main()
+{
+  sql::connection_config config;
+  config.path_to_database = ":memory:";
+  config.flags = SQLITE_OPEN_READWRITE | SQLITE_OPEN_CREATE;
+  config.debug = true;
+
+  sql::connection db(config);
+  db.execute(R"(CREATE TABLE tab_sample (
+		alpha INTEGER PRIMARY KEY,
+			beta varchar(255) DEFAULT NULL,
+			gamma bool DEFAULT NULL
+			))");
+
+  const auto tab = TabSample{};
+  for (int i = 0; i < 10; ++i)
+  {
+    db(insert_into(tab).set(tab.beta = "row " + std::to_string(i), tab.gamma = (i % 2 == 0)));
+  }
+
+  auto sessions = sessions_t{};
+  for (int64_t id = 1; id <= 20; ++id)
+  {
+    sessions[id] = session{"user " + std::to_string(id), 0.5 * static_cast<double>(id)};
+  }
+  db.create_container_table("sessions", sessions, sql::container_key_column("id", &session_id),
+                            sql::container_column("user", &session_user),
+                            sql::container_column("load", [](const sessions_t::value_type& entry)
+                                                  { return entry.second.load; }));
+
+  auto names = std::unordered_map<std::string, int64_t>{{"one", 1}, {"two", 2}, {"three", 3}};
+  db.create_container_table(
+      "names", names,
+      sql::container_key_column("name", [](const std::pair<const std::string, int64_t>& entry) -> const std::string&
+                                { return entry.first; }),
+      sql::container_column("value", [](const std::pair<const std::string, int64_t>& entry) { return entry.second; }));
+
+  const auto numbers = std::vector<int64_t>{3, 5, 7};
+  db.create_container_table("numbers", numbers, sql::container_column("value", [](int64_t value) { return value; }));
+
+  // full scan, equality lookup and range lookup
+  assert(sum_of(db, "SELECT id FROM sessions") == 210);
+  assert(sum_of(db, "SELECT id FROM sessions WHERE id = 7") == 7);
+  assert(sum_of(db, "SELECT id FROM sessions WHERE id > 5 AND id <= 8") == 6 + 7 + 8);
+  assert(sum_of(db, "SELECT id FROM sessions WHERE id > 8 AND id < 5") == 0);
+  // not exactly convertible to the key: scanned, still correct
+  assert(sum_of(db, "SELECT id FROM sessions WHERE id < 3.5") == 1 + 2 + 3);
+  // the lookups of an OR are merged by rowid, which has to be the same in every scan
+  assert(sum_of(db, "SELECT id FROM sessions WHERE id = 1 OR id > 18") == 1 + 19 + 20);
+  assert(sum_of(db, "SELECT id FROM sessions WHERE id < 2 OR id > 2") == 210 - 2);
+
+  const auto user = db(custom_query(sqlpp::verbatim("SELECT user FROM sessions WHERE id = 12"))
+                           .with_result_type_of(select(sqlpp::value("").as(result))))
+                        .front()
+                        .result;
+  std::cerr << "user: " << user << std::endl;
+  assert(user == "user 12");
+
+  assert(sum_of(db, "SELECT value FROM names WHERE name = 'two'") == 2);
+  assert(sum_of(db, "SELECT value FROM numbers") == 15);
+
+  // exceptions of any type thrown by accessors fail the query
+  db.create_container_table("failing", numbers, sql::container_column("value", &failing_value));
+  try
+  {
+    sum_of(db, "SELECT value FROM failing");
+    assert(false);
+  }
+  catch (const sqlpp::exception&)
+  {
+  }
+
+  // sorted descending: lower_bound()/upper_bound() do not match sqlite3's order, so ranges are scanned
+  auto descending = std::map<int64_t, int64_t, std::greater<int64_t>>{};
+  for (int64_t id = 1; id <= 20; ++id)
+  {
+    descending[id] = id;
+  }
+  db.create_container_table("descending", descending,
+                            sql::container_key_column("id", [](const std::pair<const int64_t, int64_t>& entry)
+                                                      { return entry.first; }));
+  assert(sum_of(db, "SELECT id FROM descending WHERE id = 7") == 7);
+  assert(sum_of(db, "SELECT id FROM descending WHERE id > 5 AND id <= 8") == 6 + 7 + 8);
+  const auto first = db(custom_query(sqlpp::verbatim("SELECT id FROM descending ORDER BY id LIMIT 1"))
+                            .with_result_type_of(select(sqlpp::value(0).as(result))))
+                         .front()
+                         .result;
+  assert(first == 1);
+
+  // joins against real tables, alpha is 1..10
+  assert(sum_of(db, "SELECT s.id FROM tab_sample t JOIN sessions s ON s.id = t.alpha WHERE t.gamma") ==
+         1 + 3 + 5 + 7 + 9);
+
+  return 0;
+}
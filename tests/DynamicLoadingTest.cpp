@@ -55,6 +55,14 @@ int main()
   config.debug = true;
 
   sql::connection db(config);
+
+  // the library is loaded once, further calls return right away
+  sql::dynamic::init_sqlite("");
+  for (const auto& name : sql::dynamic::missing_symbols())
+  {
+    std::cerr << "optional function not available: " << name << std::endl;
+  }
+
   db.execute("CREATE TABLE tab_sample (\
         alpha bigint(20) DEFAULT NULL,\
             beta varchar(255) DEFAULT NULL,\
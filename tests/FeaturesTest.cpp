@@ -0,0 +1,101 @@
+/*
+ * Copyright (c) 2015 - 2016, Roland Bock
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ *  * Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ * LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE
+ * OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ * OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+#include <cassert>
+#include <sqlpp11/exception.h>
+#include <sqlpp11/sqlite3/connection.h>
+
+#ifdef SQLPP_USE_SQLCIPHER
+#include <sqlcipher/sqlite3.h>
+#else
+#include <sqlite3.h>
+#endif
+#include <iostream>
+
+namespace sql = sqlpp::sqlite3;
+
+int main()
+{
+  sql::connection db({":memory:", SQLITE_OPEN_READWRITE | SQLITE_OPEN_CREATE, "", true});
+
+  const auto& features = db.features();
+  std::cerr << "sqlite3 " << features.version_number << ": upsert " << features.upsert << ", returning "
+            << features.returning << ", window functions " << features.window_functions << ", prepare_v3 "
+            << features.prepare_v3 << ", serialize " << features.serialize << ", carray " << features.carray
+            << std::endl;
+
+  // probed once per process
+  assert(&features == &sql::runtime_features());
+  assert(features.version_number >= 3007000);
+  assert(features.upsert == (features.version_number >= 3024000));
+  assert(features.returning == (features.version_number >= 3035000));
+  assert(not features.returning or features.upsert);
+
+  // the probe agrees with the library
+  db.execute("CREATE TABLE tab_sample (alpha INTEGER PRIMARY KEY, beta varchar(255) UNIQUE)");
+  try
+  {
+    db.execute("INSERT INTO tab_sample (beta) VALUES ('a') ON CONFLICT DO NOTHING");
+    assert(features.upsert);
+  }
+  catch (const sqlpp::exception&)
+  {
+    assert(not features.upsert);
+  }
+
+  // unsupported features fail cleanly instead of crashing
+  struct sum
+  {
+    int64_t total = 0;
+    void step(int64_t value)
+    {
+      total += value;
+    }
+    void inverse(int64_t value)
+    {
+      total -= value;
+    }
+    int64_t value() const
+    {
+      return total;
+    }
+    int64_t final() const
+    {
+      return total;
+    }
+  };
+#if SQLITE_VERSION_NUMBER >= 3025000
+  try
+  {
+    db.register_window_function<sum>("running_sum");
+    assert(features.window_functions);
+  }
+  catch (const sqlpp::exception&)
+  {
+    assert(not features.window_functions);
+  }
+#endif
+
+  return 0;
+}
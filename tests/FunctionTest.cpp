@@ -0,0 +1,129 @@
+/*
+ * Copyright (c) 2015 - 2016, Roland Bock
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ *  * Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ * LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE
+ * OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ * OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "TabSample.h"
+#include <cassert>
+#include <sqlpp11/custom_query.h>
+#include <sqlpp11/sqlite3/connection.h>
+#include <sqlpp11/sqlpp11.h>
+
+#ifdef SQLPP_USE_SQLCIPHER
+#include <sqlcipher/sqlite3.h>
+#else
+#include <sqlite3.h>
+#endif
+#include <iostream>
+#include <stdexcept>
+#include <vector>
+
+namespace sql = sqlpp::sqlite3;
+
+SQLPP_ALIAS_PROVIDER(result)
+
+namespace
+{
+  int64_t twice(int64_t value)
+  {
+    return 2 * value;
+  }
+}
+
+int main()
+{
+  sql::connection_config config;
+  config.path_to_database = ":memory:";
+  config.flags = SQLITE_OPEN_READWRITE | SQLITE_OPEN_CREATE;
+  config.debug = true;
+
+  sql::connection db(config);
+  db.execute(R"(CREATE TABLE tab_sample (
+		alpha INTEGER PRIMARY KEY,
+			beta varchar(255) DEFAULT NULL,
+			gamma bool DEFAULT NULL
+			))");
+
+  const auto tab = TabSample{};
+  for (int i = 0; i < 10; ++i)
+  {
+    db(insert_into(tab).set(tab.beta = "row " + std::to_string(i), tab.gamma = (i % 2 == 0)));
+  }
+
+  db.register_function("twice", &twice, SQLITE_DETERMINISTIC);
+  const auto bits = 3;
+  db.register_function("low_bits", [bits](int64_t value) { return value & ((1 << bits) - 1); },
+                       SQLITE_DETERMINISTIC);
+  db.register_function("tag", [](const std::string& text, double weight) { return text + ":" + std::to_string(weight); });
+  db.register_function("is_null", [](sqlite3_value* value) { return sqlite3_value_type(value) == SQLITE_NULL; });
+  db.register_function("fail", [](int64_t) -> int64_t { throw std::runtime_error("failing on purpose"); });
+  db.register_function("fail_unknown", [](int64_t) -> int64_t { throw 42; });
+
+  // Filtering inside sqlite3
+  auto sum = int64_t{0};
+  for (const auto& row : db(select(sqlpp::verbatim<sqlpp::integer>("twice(alpha)").as(result))
+                                .from(tab)
+                                .where(sqlpp::verbatim<sqlpp::boolean>("low_bits(alpha) = 1"))))
+  {
+    sum += row.result;
+  }
+  std::cerr << "Expecting twice(1) + twice(9) = 20, got " << sum << std::endl;
+  assert(sum == 20);
+
+  const auto tagged = db(custom_query(sqlpp::verbatim("SELECT tag('alpha', 0.5)"))
+                             .with_result_type_of(select(sqlpp::value("").as(result))))
+                          .front()
+                          .result;
+  std::cerr << "tag: " << tagged << std::endl;
+  assert(tagged == "alpha:0.500000");
+
+  const auto null_check = db(custom_query(sqlpp::verbatim("SELECT is_null(NULL)"))
+                                 .with_result_type_of(select(sqlpp::value(true).as(result))))
+                              .front()
+                              .result;
+  assert(null_check);
+
+  try
+  {
+    db.execute("SELECT fail(1)");
+    assert(false);
+  }
+  catch (const sqlpp::exception& e)
+  {
+    std::cerr << "Expected exception: " << e.what() << std::endl;
+  }
+
+  // exceptions of other types must not unwind through sqlite3 either
+  try
+  {
+    db.execute("SELECT fail_unknown(1)");
+    assert(false);
+  }
+  catch (const sqlpp::exception& e)
+  {
+    std::cerr << "Expected exception: " << e.what() << std::endl;
+    assert(std::string(e.what()).find("unknown exception") != std::string::npos);
+  }
+
+  return 0;
+}
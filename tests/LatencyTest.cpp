@@ -0,0 +1,142 @@
+/*
+ * Copyright (c) 2015 - 2016, Roland Bock
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ *  * Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ * LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE
+ * OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ * OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+#include "TabSample.h"
+#include <cassert>
+#include <sqlpp11/sqlite3/connection.h>
+#include <sqlpp11/sqlite3/latency.h>
+#include <sqlpp11/sqlpp11.h>
+
+#ifdef SQLPP_USE_SQLCIPHER
+#include <sqlcipher/sqlite3.h>
+#else
+#include <sqlite3.h>
+#endif
+#include <iostream>
+#include <string>
+
+namespace sql = sqlpp::sqlite3;
+
+int main()
+{
+  // every value is reported within 1/16 of itself
+  sql::latency_histogram histogram;
+  assert(histogram.count() == 0);
+  assert(histogram.percentile(50) == 0);
+  for (uint64_t value = 1; value <= 1000; ++value)
+    histogram.record(value);
+  assert(histogram.count() == 1000);
+  assert(histogram.min() == 1);
+  assert(histogram.max() == 1000);
+  assert(histogram.mean() == 500.5);
+  assert(histogram.percentile(0) == 1);
+  assert(histogram.percentile(50) >= 500 and histogram.percentile(50) <= 500 + 500 / 16);
+  assert(histogram.percentile(100) == 1000);
+
+  sql::latency_histogram other;
+  other.record(uint64_t{1} << 50);  // beyond the largest bucket
+  histogram.merge(other);
+  assert(histogram.count() == 1001);
+  assert(histogram.percentile(100) == uint64_t{1} << 50);
+
+  sql::connection_config config;
+  config.path_to_database = ":memory:";
+  config.flags = SQLITE_OPEN_READWRITE | SQLITE_OPEN_CREATE;
+
+  const auto tab = TabSample{};
+  const auto create = R"(CREATE TABLE tab_sample (
+		alpha INTEGER PRIMARY KEY,
+			beta varchar(255) DEFAULT NULL,
+			gamma bool DEFAULT NULL
+			))";
+
+  // off by default
+  {
+    sql::connection db(config);
+    db.execute(create);
+    assert(db.latency().empty());
+  }
+
+  config.latency_histograms = true;
+  sql::latency_report total;
+  for (int i = 0; i < 2; ++i)
+  {
+    sql::connection db(config);
+    db.execute(create);
+
+    auto insert = db.prepare(insert_into(tab).set(tab.beta = parameter(tab.beta), tab.gamma = parameter(tab.gamma)));
+    for (int row = 0; row < 10; ++row)
+    {
+      insert.params.beta = "row " + std::to_string(row);
+      insert.params.gamma = row % 2 == 0;
+      db(insert);
+    }
+    auto select = db.prepare(select(tab.alpha, tab.beta).from(tab).unconditionally());
+    size_t rows = 0;
+    for (const auto& row : db(select))
+    {
+      assert(not row.beta.is_null());
+      ++rows;
+    }
+    assert(rows == 10);
+
+    const auto report = db.latency();
+    bool insert_found = false;
+    bool select_found = false;
+    for (const auto& entry : report)
+    {
+      const auto& latency = entry.second;
+      if (entry.first.find("INSERT") == 0)
+      {
+        insert_found = true;
+        assert(latency.prepare.count() == 1);
+        assert(latency.bind.count() == 20);  // two parameters per row
+        assert(latency.step.count() == 10);
+        assert(latency.reset.count() == 10);
+      }
+      if (entry.first.find("SELECT") == 0)
+      {
+        select_found = true;
+        assert(latency.step.count() == 11);    // one per row, plus SQLITE_DONE
+        assert(latency.decode.count() == 20);  // two columns per row
+      }
+    }
+    assert(insert_found and select_found);
+    sql::merge(total, report);
+  }
+
+  // aggregated across both connections
+  for (const auto& entry : total)
+  {
+    if (entry.first.find("INSERT") == 0)
+      assert(entry.second.bind.count() == 40);
+  }
+
+  const auto json = sql::to_json(total);
+  std::cerr << json << std::endl;
+  assert(json.front() == '{' and json.back() == '}');
+  assert(json.find("\"step\":{\"count\":") != std::string::npos);
+
+  return 0;
+}
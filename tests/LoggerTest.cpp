@@ -0,0 +1,147 @@
+/*
+ * Copyright (c) 2015 - 2016, Roland Bock
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ *  * Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ * LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE
+ * OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ * OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+#include "TabSample.h"
+#include <cassert>
+#include <sqlpp11/sqlite3/connection.h>
+#include <sqlpp11/sqlite3/logger.h>
+#include <sqlpp11/sqlpp11.h>
+
+#ifdef SQLPP_USE_SQLCIPHER
+#include <sqlcipher/sqlite3.h>
+#else
+#include <sqlite3.h>
+#endif
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <sstream>
+#include <thread>
+#include <vector>
+
+namespace sql = sqlpp::sqlite3;
+
+namespace
+{
+  struct collecting_logger : public sql::logger
+  {
+    std::mutex mutex;
+    std::vector<sql::log_record> records;
+
+    void log(const sql::log_record& record) override
+    {
+      std::lock_guard<std::mutex> lock(mutex);
+      records.push_back(record);
+    }
+  };
+
+  size_t count_lines(const std::string& text)
+  {
+    size_t lines = 0;
+    for (const auto c : text)
+      lines += c == '\n';
+    return lines;
+  }
+}  // namespace
+
+int main()
+{
+  auto collector = std::make_shared<collecting_logger>();
+
+  sql::connection_config config;
+  config.path_to_database = ":memory:";
+  config.flags = SQLITE_OPEN_READWRITE | SQLITE_OPEN_CREATE;
+  config.debug = true;
+  config.log = collector;
+
+  const auto tab = TabSample{};
+  {
+    sql::connection db(config);
+    db.execute(R"(CREATE TABLE tab_sample (
+		alpha INTEGER PRIMARY KEY,
+			beta varchar(255) DEFAULT NULL,
+			gamma bool DEFAULT NULL
+			))");
+    auto prepared = db.prepare(insert_into(tab).set(tab.beta = parameter(tab.beta), tab.gamma = true));
+    prepared.params.beta = "logged";
+    db(prepared);
+    for (const auto& row : db(select(tab.beta).from(tab).unconditionally()))
+      assert(row.beta == "logged");
+
+    auto tx = start_transaction(db);
+    // tx is rolled back (and reported) when leaving the scope
+  }
+
+  bool prepare_logged = false;
+  bool parameter_logged = false;
+  bool duration_logged = false;
+  bool rollback_reported = false;
+  for (const auto& record : collector->records)
+  {
+    std::cerr << sql::format(record) << std::endl;
+    prepare_logged |= record.level == sql::log_level::debug and record.message.find("Preparing") == 0;
+    parameter_logged |= record.statement != nullptr and record.index == 0;
+    duration_logged |= record.duration >= std::chrono::microseconds(0);
+    rollback_reported |= record.level == sql::log_level::warning;
+  }
+  assert(prepare_logged);
+  assert(parameter_logged);
+  assert(duration_logged);
+  assert(rollback_reported);
+
+  // without debug, only warnings and errors are logged
+  collector->records.clear();
+  config.debug = false;
+  {
+    sql::connection db(config);
+    db.execute("SELECT 1");
+    auto tx = start_transaction(db);
+  }
+  assert(collector->records.size() == 1);
+  assert(collector->records.front().level == sql::log_level::warning);
+
+  // records of several threads are formatted and written in the background
+  std::ostringstream out;
+  {
+    sql::async_logger logger(out);
+    std::vector<std::thread> threads;
+    for (int t = 0; t < 4; ++t)
+    {
+      threads.emplace_back([&logger] {
+        for (int i = 0; i < 1000; ++i)
+          logger.log(sql::log_record(sql::log_level::debug, "message", nullptr, i));
+      });
+    }
+    for (auto& thread : threads)
+      thread.join();
+    logger.flush();
+    assert(count_lines(out.str()) == 4000);
+    assert(out.str().find("Sqlite3 debug: message [index=999]\n") != std::string::npos);
+
+    logger.log(sql::log_record(sql::log_level::error, "written on destruction"));
+  }
+  assert(out.str().find("Sqlite3 error: written on destruction\n") != std::string::npos);
+
+  return 0;
+}
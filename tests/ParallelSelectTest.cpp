@@ -0,0 +1,116 @@
+/*
+ * Copyright (c) 2015 - 2016, Roland Bock
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ *  * Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ * LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE
+ * OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ * OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+#include "TabSample.h"
+#include <cassert>
+#include <sqlpp11/sqlite3/connection.h>
+#include <sqlpp11/sqlite3/parallel_select.h>
+#include <sqlpp11/sqlpp11.h>
+
+#ifdef SQLPP_USE_SQLCIPHER
+#include <sqlcipher/sqlite3.h>
+#else
+#include <sqlite3.h>
+#endif
+#include <atomic>
+#include <cstdio>
+#include <iostream>
+
+namespace sql = sqlpp::sqlite3;
+
+int main()
+{
+  // every range is read on a connection of its own, so the database must be a file
+  const auto path = std::string("parallel_select_test.db");
+  std::remove(path.c_str());
+
+  sql::connection_config config;
+  config.path_to_database = path;
+  config.flags = SQLITE_OPEN_READWRITE | SQLITE_OPEN_CREATE;
+  config.debug = true;
+
+  sql::connection db(config);
+  db.execute("PRAGMA journal_mode = WAL");
+  db.execute(R"(CREATE TABLE tab_sample (
+		alpha INTEGER PRIMARY KEY,
+			beta varchar(255) DEFAULT NULL,
+			gamma bool DEFAULT NULL
+			))");
+
+  const auto tab = TabSample{};
+  const auto sum_range = [&tab](sql::connection& reader, sql::rowid_range range) -> int64_t {
+    int64_t sum = 0;
+    for (const auto& row : reader(select(tab.alpha).from(tab).where(tab.alpha >= range.first and tab.alpha <= range.last)))
+      sum += row.alpha;
+    return sum;
+  };
+  const auto add = [](int64_t lhs, int64_t rhs) { return lhs + rhs; };
+
+  // empty table
+  assert(sql::split_rowid_range(db, "tab_sample", 4).empty());
+  assert(sql::parallel_select(config, "tab_sample", 4, sum_range, int64_t{0}, add) == 0);
+
+  {
+    auto tx = start_transaction(db);
+    for (int64_t i = 1; i <= 1000; ++i)
+      db(insert_into(tab).set(tab.alpha = i, tab.gamma = true));
+    tx.commit();
+  }
+
+  // disjoint ranges covering all rowids
+  const auto ranges = sql::split_rowid_range(db, "tab_sample", 3);
+  assert(ranges.size() == 3);
+  assert(ranges.front().first == 1);
+  assert(ranges.back().last == 1000);
+  for (size_t i = 1; i < ranges.size(); ++i)
+    assert(ranges[i].first == ranges[i - 1].last + 1);
+  assert(sql::split_rowid_range(db, "tab_sample", 5000).size() == 1000);
+
+  // all ranges see the same state, even if another connection writes meanwhile
+  std::atomic<int> calls{0};
+  const auto total = sql::parallel_select(
+      config, "tab_sample", 4,
+      [&](sql::connection& reader, sql::rowid_range range) {
+        if (++calls == 1)
+          db(insert_into(tab).set(tab.alpha = 5000, tab.gamma = false));
+        return sum_range(reader, range);
+      },
+      int64_t{0}, add);
+  std::cerr << "sum: " << total << std::endl;
+  assert(calls == 4);
+  assert(total == 500500);
+  assert(sql::parallel_select(config, "tab_sample", 2, sum_range, int64_t{0}, add) == 505500);
+
+  try
+  {
+    sql::parallel_select(config, "no_such_table", 2, sum_range, int64_t{0}, add);
+    assert(false);
+  }
+  catch (const sqlpp::exception& e)
+  {
+    std::cerr << "expected error: " << e.what() << std::endl;
+  }
+
+  return 0;
+}
@@ -0,0 +1,97 @@
+/*
+ * Copyright (c) 2015 - 2016, Roland Bock
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ *  * Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ * LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE
+ * OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ * OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+#include "TabSample.h"
+#include <cassert>
+#include <sqlpp11/sqlite3/connection.h>
+#include <sqlpp11/sqlpp11.h>
+
+#ifdef SQLPP_USE_SQLCIPHER
+#include <sqlcipher/sqlite3.h>
+#else
+#include <sqlite3.h>
+#endif
+#include <iostream>
+
+namespace sql = sqlpp::sqlite3;
+
+namespace
+{
+  void create_table(sql::connection& db)
+  {
+    db.execute(R"(CREATE TABLE tab_sample (
+		alpha INTEGER PRIMARY KEY,
+			beta varchar(255) DEFAULT NULL,
+			gamma bool DEFAULT NULL
+			))");
+  }
+}  // namespace
+
+int main()
+{
+  sql::connection_config config;
+  config.path_to_database = ":memory:";
+  config.flags = SQLITE_OPEN_READWRITE | SQLITE_OPEN_CREATE;
+  config.debug = true;
+
+  const auto tab = TabSample{};
+  {
+    // explicitly prepared statements are persistent, they keep working across many executions
+    sql::connection db(config);
+    create_table(db);
+    auto insert = db.prepare(insert_into(tab).set(tab.beta = parameter(tab.beta), tab.gamma = true));
+    for (int i = 0; i < 100; ++i)
+    {
+      insert.params.beta = "prepared";
+      db(insert);
+    }
+    auto count_rows = db.prepare(select(count(tab.alpha)).from(tab).unconditionally());
+    assert(db(count_rows).front().count == 100);
+    assert(db(count_rows).front().count == 100);
+
+    // virtual tables are allowed by default
+    db.execute("SELECT * FROM pragma_table_info('tab_sample')");
+  }
+
+#if SQLITE_VERSION_NUMBER >= 3020000
+  if (sql::runtime_features().prepare_v3)
+  {
+    config.prepare_flags = SQLITE_PREPARE_NO_VTAB;
+    sql::connection db(config);
+    create_table(db);
+    db(insert_into(tab).set(tab.beta = "plain", tab.gamma = false));
+    try
+    {
+      db.execute("SELECT * FROM pragma_table_info('tab_sample')");
+      assert(false);
+    }
+    catch (const sqlpp::exception& e)
+    {
+      std::cerr << "Expected: " << e.what() << std::endl;
+    }
+  }
+#endif
+
+  return 0;
+}
@@ -0,0 +1,96 @@
+/*
+ * Copyright (c) 2015 - 2016, Roland Bock
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ *  * Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ * LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE
+ * OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ * OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+#include "TabSample.h"
+#include <cassert>
+#include <sqlpp11/sqlite3/shared_cache_pool.h>
+#include <sqlpp11/sqlpp11.h>
+
+#ifdef SQLPP_USE_SQLCIPHER
+#include <sqlcipher/sqlite3.h>
+#else
+#include <sqlite3.h>
+#endif
+#include <iostream>
+
+namespace sql = sqlpp::sqlite3;
+
+int main()
+{
+  sql::shared_cache_pool pool("read_only_routing_test", 2, true);
+  const auto tab = TabSample{};
+
+  {
+    auto writer = pool.writer();
+    writer->execute(R"(CREATE TABLE tab_sample (
+		alpha INTEGER PRIMARY KEY,
+			beta varchar(255) DEFAULT NULL,
+			gamma bool DEFAULT NULL
+			))");
+
+    // classification at prepare time
+    auto select_prepared = writer->prepare(select(tab.alpha).from(tab).unconditionally());
+    assert(select_prepared._prepared_statement.is_read_only());
+    auto insert_prepared = writer->prepare(insert_into(tab).set(tab.beta = "prepared", tab.gamma = true));
+    assert(not insert_prepared._prepared_statement.is_read_only());
+    assert(writer->is_read_only("SELECT 1"));
+    assert(not writer->is_read_only("DELETE FROM tab_sample"));
+  }
+
+  // writes go to the writer (readers are query only and would fail)
+  for (int i = 0; i < 10; ++i)
+  {
+    pool(insert_into(tab).set(tab.beta = "routed", tab.gamma = true));
+  }
+  pool(update(tab).set(tab.gamma = false).where(tab.alpha == 1));
+
+  // reads go to a reader
+  {
+    auto routed = pool(select(tab.alpha, tab.gamma).from(tab).unconditionally());
+    int count = 0;
+    for (const auto& row : routed.result)
+    {
+      assert(row.gamma == (row.alpha != 1));
+      ++count;
+    }
+    assert(count == 10);
+
+    // the writer is not tied up by the read
+    auto writer = pool.writer();
+    (*writer)(remove_from(tab).where(tab.alpha == 10));
+  }
+  assert(pool.open_readers() >= 1);
+  assert(pool(select(count(tab.alpha)).from(tab).unconditionally()).result.front().count == 9);
+
+  // writes do not wait for readers, even if the statement has not been classified yet
+  {
+    auto first = pool.reader();
+    auto second = pool.reader();
+    pool(insert_into(tab).set(tab.beta = "routed", tab.gamma = true));
+    pool(insert_into(tab).set(tab.beta = "not classified yet", tab.gamma = true));
+  }
+  assert(pool(select(count(tab.alpha)).from(tab).unconditionally()).result.front().count == 11);
+
+  return 0;
+}
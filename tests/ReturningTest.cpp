@@ -0,0 +1,103 @@
+/*
+ * Copyright (c) 2015 - 2016, Roland Bock
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ *  * Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ * LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE
+ * OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ * OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "TabSample.h"
+#include <cassert>
+#include <sqlpp11/sqlite3/sqlite3.h>
+#include <sqlpp11/sqlpp11.h>
+
+#ifdef SQLPP_USE_SQLCIPHER
+#include <sqlcipher/sqlite3.h>
+#else
+#include <sqlite3.h>
+#endif
+#include <iostream>
+
+namespace sql = sqlpp::sqlite3;
+
+int main()
+{
+#if SQLITE_VERSION_NUMBER >= 3035000
+  sql::connection_config config;
+  config.path_to_database = ":memory:";
+  config.flags = SQLITE_OPEN_READWRITE | SQLITE_OPEN_CREATE;
+  config.debug = true;
+
+  sql::connection db(config);
+  db.execute(R"(CREATE TABLE tab_sample (
+		alpha INTEGER PRIMARY KEY,
+			beta varchar(255) DEFAULT 'generated',
+			gamma bool DEFAULT NULL
+			))");
+
+  const auto tab = TabSample{};
+
+  // generated key and default value in one step
+  {
+    auto result = db(sql::insert_into(tab).set(tab.gamma = true).returning(tab.alpha, tab.beta));
+    const auto& row = result.front();
+    std::cerr << "inserted " << row.alpha << ", " << row.beta << std::endl;
+    assert(row.alpha == 1);
+    assert(row.beta == "generated");
+  }
+
+  auto prepared_insert =
+      db.prepare(sql::insert_into(tab).set(tab.beta = parameter(tab.beta), tab.gamma = false).returning(tab.alpha));
+  for (int i = 0; i < 3; ++i)
+  {
+    prepared_insert.params.beta = "row " + std::to_string(i);
+    const auto alpha = db(prepared_insert).front().alpha;
+    assert(alpha == i + 2);
+  }
+
+  {
+    auto result = db(
+        sql::insert_or_replace_into(tab).set(tab.beta = "replaced", tab.gamma = true).returning(tab.alpha, tab.gamma));
+    const auto& row = result.front();
+    assert(row.alpha == 5);
+    assert(row.gamma);
+  }
+
+  auto updated = 0;
+  for (const auto& row : db(sql::update(tab).set(tab.gamma = true).where(tab.alpha > 2).returning(tab.alpha, tab.gamma)))
+  {
+    assert(row.alpha > 2);
+    assert(row.gamma);
+    ++updated;
+  }
+  assert(updated == 3);
+
+  auto removed = 0;
+  for (const auto& row : db(sql::remove_from(tab).where(tab.gamma == false).returning(tab.beta)))
+  {
+    std::cerr << "removed " << row.beta << std::endl;
+    assert(row.beta == "row 0");
+    ++removed;
+  }
+  assert(removed == 1);
+#endif
+
+  return 0;
+}
@@ -0,0 +1,150 @@
+/*
+ * Copyright (c) 2015 - 2016, Roland Bock
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ *  * Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ * LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE
+ * OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ * OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+#include "TabSample.h"
+#include <cassert>
+#include <sqlpp11/sqlite3/connection.h>
+#include <sqlpp11/sqlpp11.h>
+#include <sqlpp11/transaction.h>
+
+#ifdef SQLPP_USE_SQLCIPHER
+#include <sqlcipher/sqlite3.h>
+#else
+#include <sqlite3.h>
+#endif
+#include <iostream>
+#include <stdexcept>
+
+namespace sql = sqlpp::sqlite3;
+
+namespace
+{
+  const auto tab = TabSample{};
+
+  size_t row_count(sql::connection& db)
+  {
+    return static_cast<size_t>(db(select(count(tab.alpha)).from(tab).unconditionally()).front().count);
+  }
+
+  // library code using its own transactional scope
+  void insert_two(sql::connection& db, bool fail)
+  {
+    auto tx = start_transaction(db);
+    db(insert_into(tab).set(tab.beta = "first", tab.gamma = true));
+    if (fail)
+      throw std::runtime_error("failed halfway");
+    db(insert_into(tab).set(tab.beta = "second", tab.gamma = false));
+    tx.commit();
+  }
+}  // namespace
+
+int main()
+{
+  sql::connection db({":memory:", SQLITE_OPEN_READWRITE | SQLITE_OPEN_CREATE, "", true});
+  db.execute(R"(CREATE TABLE tab_sample (
+		alpha INTEGER PRIMARY KEY,
+			beta varchar(255) DEFAULT NULL,
+			gamma bool DEFAULT NULL
+			))");
+
+  assert(db.transaction_depth() == 0);
+  {
+    auto outer = start_transaction(db);
+    assert(db.transaction_depth() == 1);
+
+    insert_two(db, false);
+    assert(db.transaction_depth() == 1);
+    assert(row_count(db) == 2);
+
+    // the failing scope is rolled back to its savepoint, the outer transaction survives
+    try
+    {
+      insert_two(db, true);
+      assert(false);
+    }
+    catch (const std::runtime_error&)
+    {
+    }
+    assert(db.transaction_depth() == 1);
+    assert(row_count(db) == 2);
+
+    {
+      auto inner = start_transaction(db);
+      auto innermost = start_transaction(db);
+      assert(db.transaction_depth() == 3);
+      db(insert_into(tab).set(tab.beta = "third", tab.gamma = true));
+      innermost.commit();
+      inner.rollback();
+    }
+    assert(row_count(db) == 2);
+
+    outer.commit();
+  }
+  assert(db.transaction_depth() == 0);
+  assert(row_count(db) == 2);
+
+  // nothing survives if the outermost transaction is rolled back
+  {
+    auto outer = start_transaction(db);
+    insert_two(db, false);
+    outer.rollback();
+  }
+  assert(row_count(db) == 2);
+
+  // sqlite3 rolled back the whole transaction behind our back (as it may do after SQLITE_FULL or SQLITE_BUSY)
+  db.start_transaction();
+  db.start_transaction();
+  db.start_transaction();
+  assert(db.transaction_depth() == 3);
+  sqlite3_exec(db.native_handle(), "ROLLBACK", nullptr, nullptr, nullptr);
+  try
+  {
+    db.rollback_transaction(false);
+    assert(false);
+  }
+  catch (const sqlpp::exception& e)
+  {
+    std::cerr << "Expected exception: " << e.what() << std::endl;
+  }
+  assert(db.transaction_depth() == 0);
+  // a new top level transaction, not a savepoint
+  {
+    auto tx = start_transaction(db);
+    assert(db.transaction_depth() == 1);
+    db(insert_into(tab).set(tab.beta = "after", tab.gamma = true));
+    tx.commit();
+  }
+  assert(row_count(db) == 3);
+
+  try
+  {
+    db.commit_transaction();
+    assert(false);
+  }
+  catch (const sqlpp::exception&)
+  {
+  }
+
+  return 0;
+}
@@ -0,0 +1,99 @@
+/*
+ * Copyright (c) 2015 - 2016, Roland Bock
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ *  * Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ * LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE
+ * OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ * OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "TabSample.h"
+#include <cassert>
+#include <sqlpp11/sqlite3/connection.h>
+#include <sqlpp11/sqlpp11.h>
+
+#ifdef SQLPP_USE_SQLCIPHER
+#include <sqlcipher/sqlite3.h>
+#else
+#include <sqlite3.h>
+#endif
+#include <iostream>
+#include <vector>
+
+namespace sql = sqlpp::sqlite3;
+
+int main()
+{
+#if SQLITE_VERSION_NUMBER >= 3036000
+  sql::connection_config config;
+  config.path_to_database = ":memory:";
+  config.flags = SQLITE_OPEN_READWRITE | SQLITE_OPEN_CREATE;
+  config.debug = true;
+
+  sql::connection db(config);
+  // an empty database has an empty image
+  assert(db.serialize().empty());
+
+  db.execute(R"(CREATE TABLE tab_sample (
+		alpha INTEGER PRIMARY KEY,
+			beta varchar(255) DEFAULT NULL,
+			gamma bool DEFAULT NULL
+			))");
+
+  const auto tab = TabSample{};
+  for (int i = 0; i < 100; ++i)
+  {
+    db(insert_into(tab).set(tab.beta = "snapshot", tab.gamma = true));
+  }
+
+  auto image = db.serialize();
+  std::cerr << "Serialized database has " << image.size() << " bytes" << std::endl;
+  assert(not image.empty());
+  const auto bytes = std::vector<uint8_t>(image.data(), image.data() + image.size());
+
+  // Handing the image over without copying, the database stays writable
+  sql::connection writable(config);
+  writable.deserialize(std::move(image));
+  assert(image.empty());
+  writable(insert_into(tab).set(tab.beta = "more", tab.gamma = false));
+  assert(writable(select(count(tab.alpha)).from(tab).unconditionally()).front().count == 101);
+
+  // Copying bytes into a database
+  sql::connection copied(config);
+  copied.deserialize(bytes);
+  assert(copied(select(count(tab.alpha)).from(tab).unconditionally()).front().count == 100);
+
+  // Using external memory (e.g. a mmap'd file) read-only
+  auto external = bytes;
+  sql::connection read_only(config);
+  read_only.deserialize(external.data(), external.size());
+  assert(read_only(select(count(tab.alpha)).from(tab).unconditionally()).front().count == 100);
+  try
+  {
+    read_only(insert_into(tab).set(tab.beta = "fails", tab.gamma = false));
+    assert(false);
+  }
+  catch (const sqlpp::exception& e)
+  {
+    std::cerr << "Expected exception: " << e.what() << std::endl;
+  }
+#endif
+
+  return 0;
+}
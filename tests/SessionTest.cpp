@@ -0,0 +1,141 @@
+/*
+ * Copyright (c) 2015 - 2016, Roland Bock
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ *  * Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ * LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE
+ * OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ * OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+#include "TabSample.h"
+#include <cassert>
+#include <sqlpp11/exception.h>
+#include <sqlpp11/sqlite3/connection.h>
+#include <sqlpp11/sqlpp11.h>
+
+#ifdef SQLPP_USE_SQLCIPHER
+#include <sqlcipher/sqlite3.h>
+#else
+#include <sqlite3.h>
+#endif
+#include <iostream>
+
+namespace sql = sqlpp::sqlite3;
+
+int main()
+{
+  sql::connection_config config;
+  config.path_to_database = ":memory:";
+  config.flags = SQLITE_OPEN_READWRITE | SQLITE_OPEN_CREATE;
+  config.debug = true;
+
+  const auto create = R"(CREATE TABLE tab_sample (
+		alpha INTEGER PRIMARY KEY,
+			beta varchar(255) DEFAULT NULL,
+			gamma bool DEFAULT NULL
+			))";
+  sql::connection primary(config);
+  sql::connection replica(config);
+  primary.execute(create);
+  replica.execute(create);
+  primary.execute("CREATE TABLE unrelated (id INTEGER PRIMARY KEY)");
+  replica.execute("CREATE TABLE unrelated (id INTEGER PRIMARY KEY)");
+
+  const auto tab = TabSample{};
+  const auto row_count = [&tab](sql::connection& db) {
+    return db(select(count(tab.alpha)).from(tab).unconditionally()).front().count.value();
+  };
+
+#ifndef SQLITE_ENABLE_SESSION
+  // not built with SQLITE3_ENABLE_SESSION
+  try
+  {
+    primary.capture_changes(tab);
+    assert(false);
+  }
+  catch (const sqlpp::exception& e)
+  {
+    std::cerr << "session extension not available: " << e.what() << std::endl;
+  }
+  return 77;  // skipped
+#endif
+  assert(sql::runtime_features().session);
+
+  sql::changeset changes;
+  {
+    auto capture = primary.capture_changes(tab);
+    assert(capture.empty());
+
+    for (int64_t i = 1; i <= 5; ++i)
+      primary(insert_into(tab).set(tab.alpha = i, tab.beta = "inserted", tab.gamma = true));
+    primary(update(tab).set(tab.beta = "updated").where(tab.alpha == 2));
+    primary(remove_from(tab).where(tab.alpha == 5));
+    primary.execute("INSERT INTO unrelated VALUES (1)");
+
+    assert(not capture.empty());
+    changes = capture.changes();
+  }
+  std::cerr << "changeset size: " << changes.size() << std::endl;
+  assert(not changes.empty());
+
+  // a changeset can be shipped as plain bytes
+  const auto shipped = sql::changeset(changes.bytes());
+  replica.apply_changes(shipped);
+  assert(row_count(replica) == 4);
+  assert(replica(select(tab.beta).from(tab).where(tab.alpha == 2)).front().beta == "updated");
+  assert(replica(select(count(tab.alpha)).from(tab).where(tab.alpha == 5)).front().count == 0);
+  // changes to other tables were not captured (this would violate the primary key otherwise)
+  replica.execute("INSERT INTO unrelated VALUES (1)");
+
+  // applying again conflicts, which aborts by default
+  try
+  {
+    replica.apply_changes(shipped);
+    assert(false);
+  }
+  catch (const sqlpp::exception& e)
+  {
+    std::cerr << "expected error: " << e.what() << std::endl;
+  }
+  assert(row_count(replica) == 4);
+
+  // unless the handler decides otherwise
+  int conflicts = 0;
+  replica.apply_changes(shipped, [&conflicts](sql::conflict_type type, const std::string& table) {
+    assert(table == "tab_sample");
+    assert(type == sql::conflict_type::conflict or type == sql::conflict_type::data or
+           type == sql::conflict_type::not_found);
+    ++conflicts;
+    return sql::conflict_action::omit;
+  });
+  assert(conflicts > 0);
+  assert(row_count(replica) == 4);
+
+  // changes to diverged rows can be applied anyway
+  replica(update(tab).set(tab.beta = "diverged").where(tab.alpha == 1));
+  {
+    auto capture = primary.capture_changes();
+    primary(update(tab).set(tab.gamma = false).where(tab.alpha == 1));
+    replica.apply_changes(capture.changes(), [](sql::conflict_type type, const std::string&) {
+      return type == sql::conflict_type::data ? sql::conflict_action::replace : sql::conflict_action::abort;
+    });
+  }
+  assert(replica(select(tab.gamma).from(tab).where(tab.alpha == 1)).front().gamma == false);
+
+  return 0;
+}
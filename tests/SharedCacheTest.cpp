@@ -0,0 +1,112 @@
+/*
+ * Copyright (c) 2015 - 2016, Roland Bock
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ *  * Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ * LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE
+ * OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ * OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+#include "TabSample.h"
+#include <cassert>
+#include <sqlpp11/sqlite3/shared_cache_pool.h>
+#include <sqlpp11/sqlpp11.h>
+
+#ifdef SQLPP_USE_SQLCIPHER
+#include <sqlcipher/sqlite3.h>
+#else
+#include <sqlite3.h>
+#endif
+#include <atomic>
+#include <iostream>
+#include <thread>
+#include <vector>
+
+namespace sql = sqlpp::sqlite3;
+
+namespace
+{
+  const auto tab = TabSample{};
+
+  int64_t row_count(sql::connection& db)
+  {
+    return db(select(count(tab.alpha)).from(tab).unconditionally()).front().count;
+  }
+}  // namespace
+
+int main()
+{
+  sql::shared_cache_pool pool("shared_cache_test", 4, true);
+
+  {
+    auto writer = pool.writer();
+    writer->execute(R"(CREATE TABLE tab_sample (
+		alpha INTEGER PRIMARY KEY,
+			beta varchar(255) DEFAULT NULL,
+			gamma bool DEFAULT NULL
+			))");
+    for (int i = 0; i < 100; ++i)
+    {
+      (*writer)(insert_into(tab).set(tab.beta = "shared", tab.gamma = true));
+    }
+  }
+
+  // many threads read the same in-memory database
+  std::atomic<int64_t> rows{0};
+  std::vector<std::thread> threads;
+  for (int t = 0; t < 8; ++t)
+  {
+    threads.emplace_back([&pool, &rows]() {
+      for (int i = 0; i < 10; ++i)
+      {
+        auto reader = pool.reader();
+        rows += row_count(*reader);
+      }
+    });
+  }
+  for (auto& thread : threads)
+    thread.join();
+  assert(rows == 8 * 10 * 100);
+  assert(pool.open_readers() >= 1 and pool.open_readers() <= 4);
+
+  {
+    auto writer = pool.writer();
+    auto transaction = start_transaction(*writer);
+    (*writer)(insert_into(tab).set(tab.beta = "uncommitted", tab.gamma = false));
+
+    // readers neither wait for the writer nor see only committed data
+    auto reader = pool.reader();
+    assert(row_count(*reader) == 101);
+
+    // readers are limited to queries
+    try
+    {
+      (*reader)(remove_from(tab).unconditionally());
+      assert(false);
+    }
+    catch (const sqlpp::exception& e)
+    {
+      std::cerr << "Expected: " << e.what() << std::endl;
+    }
+
+    transaction.rollback();
+    assert(row_count(*reader) == 100);
+  }
+
+  return 0;
+}
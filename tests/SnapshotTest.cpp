@@ -0,0 +1,128 @@
+/*
+ * Copyright (c) 2015 - 2016, Roland Bock
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ *  * Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ * LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE
+ * OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ * OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+#include "TabSample.h"
+#include <cassert>
+#include <sqlpp11/exception.h>
+#include <sqlpp11/sqlite3/connection.h>
+#include <sqlpp11/sqlite3/snapshot.h>
+#include <sqlpp11/sqlpp11.h>
+
+#ifdef SQLPP_USE_SQLCIPHER
+#include <sqlcipher/sqlite3.h>
+#else
+#include <sqlite3.h>
+#endif
+#include <cstdio>
+#include <iostream>
+
+namespace sql = sqlpp::sqlite3;
+
+int main()
+{
+  // snapshots require WAL mode and thus a database file
+  const auto path = std::string("snapshot_test.db");
+  std::remove(path.c_str());
+
+  sql::connection_config config;
+  config.path_to_database = path;
+  config.flags = SQLITE_OPEN_READWRITE | SQLITE_OPEN_CREATE;
+  config.debug = true;
+
+  sql::connection writer(config);
+  writer.execute("PRAGMA journal_mode = WAL");
+  writer.execute(R"(CREATE TABLE tab_sample (
+		alpha INTEGER PRIMARY KEY,
+			beta varchar(255) DEFAULT NULL,
+			gamma bool DEFAULT NULL
+			))");
+
+  const auto tab = TabSample{};
+  for (int i = 0; i < 10; ++i)
+    writer(insert_into(tab).set(tab.gamma = true));
+
+  sql::connection origin(config);
+#ifndef SQLITE_ENABLE_SNAPSHOT
+  // not built with SQLITE3_ENABLE_SNAPSHOT
+  try
+  {
+    sql::snapshot state(origin);
+    assert(false);
+  }
+  catch (const sqlpp::exception& e)
+  {
+    std::cerr << "snapshots not available: " << e.what() << std::endl;
+  }
+  assert(origin.transaction_depth() == 0);
+  return 77;  // skipped
+#endif
+  assert(sql::runtime_features().snapshot);
+
+  const auto row_count = [&tab](sql::connection& db) {
+    return db(select(count(tab.alpha)).from(tab).unconditionally()).front().count.value();
+  };
+
+  // the snapshot starts a read transaction on origin
+  sql::snapshot state(origin);
+  assert(origin.transaction_depth() == 1);
+  assert(state.schema() == "main");
+
+  for (int i = 0; i < 5; ++i)
+    writer(insert_into(tab).set(tab.gamma = false));
+  assert(row_count(writer) == 15);
+
+  // other connections see the state recorded by the snapshot
+  sql::connection reader_a(config);
+  sql::connection reader_b(config);
+  state.open(reader_a);
+  state.open(reader_b);
+  assert(row_count(origin) == 10);
+  assert(row_count(reader_a) == 10);
+  assert(row_count(reader_b) == 10);
+
+  try
+  {
+    state.open(reader_a);
+    assert(false);
+  }
+  catch (const sqlpp::exception& e)
+  {
+    std::cerr << "expected error: " << e.what() << std::endl;
+  }
+
+  reader_a.commit_transaction();
+  assert(row_count(reader_a) == 15);
+
+  // still available while reader_b and origin read from it
+  auto moved = std::move(state);
+  sql::connection reader_c(config);
+  moved.open(reader_c);
+  assert(row_count(reader_c) == 10);
+
+  reader_b.commit_transaction();
+  reader_c.commit_transaction();
+  origin.commit_transaction();
+
+  return 0;
+}
@@ -0,0 +1,92 @@
+/*
+ * Copyright (c) 2015 - 2016, Roland Bock
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ *  * Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ * LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE
+ * OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ * OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+#include "TabSample.h"
+#include <cassert>
+#include <sqlpp11/sqlite3/connection.h>
+#include <sqlpp11/sqlpp11.h>
+
+#ifdef SQLPP_USE_SQLCIPHER
+#include <sqlcipher/sqlite3.h>
+#else
+#include <sqlite3.h>
+#endif
+#include <iostream>
+
+namespace sql = sqlpp::sqlite3;
+
+int main()
+{
+  sql::connection_config config;
+  config.path_to_database = ":memory:";
+  config.flags = SQLITE_OPEN_READWRITE | SQLITE_OPEN_CREATE;
+  config.debug = true;
+
+  const auto global_before = sql::global_statistics();
+
+  sql::connection db(config);
+  db.execute(R"(CREATE TABLE tab_sample (
+		alpha INTEGER PRIMARY KEY,
+			beta varchar(255) DEFAULT NULL,
+			gamma bool DEFAULT NULL
+			))");
+
+  const auto tab = TabSample{};
+  for (int i = 0; i < 100; ++i)
+  {
+    db(insert_into(tab).set(tab.beta = std::string(500, 'x'), tab.gamma = true));
+  }
+
+  const auto first = db.stats();
+  assert(first.cache_used.current > 0);
+  assert(first.schema_used.current > 0);
+  assert(first.cache_hit.total > 0);
+  assert(first.cache_hit.delta == first.cache_hit.total);
+
+  auto prepared = db.prepare(select(tab.alpha).from(tab).unconditionally());
+  for (const auto& row : db(prepared))
+  {
+    (void)row;
+  }
+
+  const auto second = db.stats();
+  std::cerr << "cache used: " << second.cache_used.current << ", hits: " << second.cache_hit.total << " (+"
+            << second.cache_hit.delta << "), misses: " << second.cache_miss.total
+            << ", hit rate: " << second.cache_hit_rate() << ", schema: " << second.schema_used.current
+            << ", statements: " << second.stmt_used.current << std::endl;
+  assert(second.stmt_used.current > 0);
+  assert(second.cache_hit.delta > 0);
+  assert(second.cache_hit.total == first.cache_hit.total + second.cache_hit.delta);
+  assert(second.cache_hit_rate() > 0.0 and second.cache_hit_rate() <= 1.0);
+  assert(second.lookaside_hit.total >= 0);
+
+  const auto global = sql::global_statistics();
+  std::cerr << "memory used: " << global.memory_used.current << " (+" << global.memory_used.delta
+            << "), allocations: " << global.malloc_count.current << std::endl;
+  assert(global.memory_used.current > 0);
+  assert(global.memory_used.highwater >= global.memory_used.current);
+  assert(global.memory_used.delta == global.memory_used.current - global_before.memory_used.current);
+
+  return 0;
+}
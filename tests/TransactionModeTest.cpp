@@ -0,0 +1,129 @@
+/*
+ * Copyright (c) 2015 - 2016, Roland Bock
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ *  * Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ * LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE
+ * OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ * OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+#include "TabSample.h"
+#include <cassert>
+#include <sqlpp11/sqlite3/connection.h>
+#include <sqlpp11/sqlpp11.h>
+#include <sqlpp11/transaction.h>
+
+#ifdef SQLPP_USE_SQLCIPHER
+#include <sqlcipher/sqlite3.h>
+#else
+#include <sqlite3.h>
+#endif
+#include <cstdio>
+#include <iostream>
+
+namespace sql = sqlpp::sqlite3;
+
+int main()
+{
+  // locking between connections requires a database file
+  const auto path = std::string("transaction_mode_test.db");
+  std::remove(path.c_str());
+
+  sql::connection_config config;
+  config.path_to_database = path;
+  config.flags = SQLITE_OPEN_READWRITE | SQLITE_OPEN_CREATE;
+  config.debug = true;
+
+  {
+    sql::connection writer(config);
+    sql::connection other(config);
+    writer.execute(R"(CREATE TABLE tab_sample (
+		alpha INTEGER PRIMARY KEY,
+			beta varchar(255) DEFAULT NULL,
+			gamma bool DEFAULT NULL
+			))");
+    const auto tab = TabSample{};
+
+    assert(writer.get_default_transaction_mode() == sql::transaction_mode::deferred);
+    {
+      auto tx = start_transaction(writer, sql::transaction_mode::immediate);
+      assert(writer.get_default_transaction_mode() == sql::transaction_mode::deferred);
+
+      // a deferred transaction does not take any lock up front
+      auto deferred = start_transaction(other);
+      deferred.commit();
+
+      // but the write lock is taken already
+      try
+      {
+        auto immediate = start_transaction(other, sql::transaction_mode::immediate);
+        assert(false);
+      }
+      catch (const sqlpp::exception& e)
+      {
+        std::cerr << "Expected: " << e.what() << std::endl;
+      }
+      assert(other.transaction_depth() == 0);
+
+      writer(insert_into(tab).set(tab.beta = "locked", tab.gamma = true));
+      tx.commit();
+    }
+
+    // the lock is gone with the transaction
+    {
+      auto immediate = start_transaction(other, sql::transaction_mode::immediate);
+      immediate.commit();
+    }
+
+    // isolation levels map to transaction modes
+    {
+      auto tx = start_transaction(writer, sqlpp::isolation_level::repeatable_read);
+      try
+      {
+        other.start_transaction(sql::transaction_mode::exclusive);
+        assert(false);
+      }
+      catch (const sqlpp::exception&)
+      {
+      }
+      tx.commit();
+    }
+
+    // the default isolation level only controls read_uncommitted, the default mode is left alone
+    writer.set_default_isolation_level(sqlpp::isolation_level::serializable);
+    assert(writer.get_default_transaction_mode() == sql::transaction_mode::deferred);
+    assert(writer.get_default_isolation_level() == sqlpp::isolation_level::serializable);
+    {
+      auto tx = start_transaction(writer);
+      auto deferred = start_transaction(other);
+      deferred.commit();
+      tx.commit();
+    }
+    writer.set_default_transaction_mode(sql::transaction_mode::immediate);
+    assert(writer.get_default_transaction_mode() == sql::transaction_mode::immediate);
+
+    config.default_transaction_mode = sql::transaction_mode::exclusive;
+    sql::connection exclusive(config);
+    assert(exclusive.get_default_transaction_mode() == sql::transaction_mode::exclusive);
+  }
+
+  std::remove(path.c_str());
+  std::remove((path + "-journal").c_str());
+
+  return 0;
+}
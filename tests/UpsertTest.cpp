@@ -0,0 +1,94 @@
+/*
+ * Copyright (c) 2015 - 2016, Roland Bock
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ *  * Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ * LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE
+ * OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ * OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "TabSample.h"
+#include <cassert>
+#include <sqlpp11/sqlite3/sqlite3.h>
+#include <sqlpp11/sqlpp11.h>
+
+#ifdef SQLPP_USE_SQLCIPHER
+#include <sqlcipher/sqlite3.h>
+#else
+#include <sqlite3.h>
+#endif
+#include <iostream>
+
+namespace sql = sqlpp::sqlite3;
+
+int main()
+{
+#if SQLITE_VERSION_NUMBER >= 3024000
+  sql::connection_config config;
+  config.path_to_database = ":memory:";
+  config.flags = SQLITE_OPEN_READWRITE | SQLITE_OPEN_CREATE;
+  config.debug = true;
+
+  sql::connection db(config);
+  db.execute(R"(CREATE TABLE tab_sample (
+		alpha INTEGER PRIMARY KEY,
+			beta varchar(255) UNIQUE,
+			gamma bool DEFAULT NULL
+			))");
+
+  const auto tab = TabSample{};
+  const auto id = db(sql::insert_into(tab).set(tab.beta = "counter", tab.gamma = false));
+
+  // DO UPDATE keeps the row (and its rowid) instead of deleting and reinserting it
+  db(sql::insert_into(tab)
+         .set(tab.beta = "counter", tab.gamma = true)
+         .on_conflict(tab.beta)
+         .do_update(tab.gamma = sql::excluded(tab.gamma)));
+  {
+    auto result = db(select(tab.alpha, tab.gamma).from(tab).where(tab.beta == "counter"));
+    const auto& row = result.front();
+    assert(row.alpha == static_cast<int64_t>(id));
+    assert(row.gamma);
+  }
+
+  // DO NOTHING
+  db(sql::insert_into(tab).set(tab.beta = "counter", tab.gamma = false).on_conflict(tab.beta).do_nothing());
+  db(sql::insert_into(tab).set(tab.beta = "counter", tab.gamma = false).on_conflict().do_nothing());
+  assert(db(select(tab.gamma).from(tab).where(tab.beta == "counter")).front().gamma);
+
+  // prepared, alternately inserting and updating
+  auto prepared = db.prepare(sql::insert_into(tab)
+                                 .set(tab.beta = parameter(tab.beta), tab.gamma = parameter(tab.gamma))
+                                 .on_conflict(tab.beta)
+                                 .do_update(tab.gamma = sql::excluded(tab.gamma)));
+  for (int i = 0; i < 4; ++i)
+  {
+    prepared.params.beta = (i % 2) ? "counter" : "other";
+    prepared.params.gamma = (i < 2);
+    db(prepared);
+  }
+  const auto row_count = db(select(count(tab.alpha)).from(tab).unconditionally()).front().count;
+  std::cerr << "rows: " << row_count << std::endl;
+  assert(row_count == 2);
+  assert(not db(select(tab.gamma).from(tab).where(tab.beta == "counter")).front().gamma);
+  assert(not db(select(tab.gamma).from(tab).where(tab.beta == "other")).front().gamma);
+#endif
+
+  return 0;
+}